@@ -95,6 +95,10 @@ void ComputerControlInterface::start( QSize scaledFramebufferSize, UpdateMode up
 		connect( vncConnection, &VncConnection::framebufferUpdateComplete, this, [this]() {
 			resetWatchdog();
 			++m_timestamp;
+			if( skipsFramebufferUpdates() == false )
+			{
+				m_framebufferOutdated = false;
+			}
 			Q_EMIT scaledFramebufferUpdated();
 		} );
 
@@ -225,6 +229,19 @@ QImage ComputerControlInterface::framebuffer() const
 
 
 
+bool ComputerControlInterface::refreshFramebuffer()
+{
+	if( m_framebufferOutdated && vncConnection() && vncConnection()->isConnected() )
+	{
+		vncConnection()->requestFullFramebufferUpdate();
+		return true;
+	}
+
+	return false;
+}
+
+
+
 void ComputerControlInterface::setAccessControlFailed(const QString& details)
 {
 	lock();
@@ -329,7 +346,14 @@ void ComputerControlInterface::sendFeatureMessage(const FeatureMessage& featureM
 {
 	if( m_connection && m_connection->isConnected() )
 	{
-		m_connection->sendFeatureMessage(featureMessage);
+		if (m_serverVersion >= VeyonCore::ApplicationVersion::Version_5_0)
+		{
+			m_connection->sendFeatureMessage(FeatureMessage{featureMessage}.setCompressionAllowed(true));
+		}
+		else
+		{
+			m_connection->sendFeatureMessage(featureMessage);
+		}
 	}
 }
 
@@ -362,6 +386,39 @@ void ComputerControlInterface::setUpdateMode( UpdateMode updateMode )
 
 
 
+void ComputerControlInterface::setFramebufferUpdatesSuspended( bool suspended )
+{
+	if( suspended != m_framebufferUpdatesSuspended )
+	{
+		m_framebufferUpdatesSuspended = suspended;
+
+		setMinimumFramebufferUpdateInterval();
+	}
+}
+
+
+
+void ComputerControlInterface::setFramebufferInUse( const QObject* user, bool inUse )
+{
+	const auto wasSkipping = skipsFramebufferUpdates();
+
+	if( inUse )
+	{
+		m_framebufferUsers.insert( user );
+	}
+	else
+	{
+		m_framebufferUsers.remove( user );
+	}
+
+	if( skipsFramebufferUpdates() != wasSkipping )
+	{
+		setMinimumFramebufferUpdateInterval();
+	}
+}
+
+
+
 void ComputerControlInterface::setProperty(QUuid propertyId, const QVariant& data)
 {
 	if (propertyId.isNull() == false)
@@ -423,15 +480,17 @@ void ComputerControlInterface::setMinimumFramebufferUpdateInterval()
 		break;
 
 	case UpdateMode::FeatureControlOnly:
-		if (vncConnection())
-		{
-			vncConnection()->setSkipFramebufferUpdates(true);
-		}
 		break;
 	}
 
+	if (skipsFramebufferUpdates())
+	{
+		m_framebufferOutdated = true;
+	}
+
 	if (vncConnection())
 	{
+		vncConnection()->setSkipFramebufferUpdates(m_updateMode == UpdateMode::FeatureControlOnly || skipsFramebufferUpdates());
 		vncConnection()->setFramebufferUpdateInterval(updateInterval);
 	}
 
@@ -443,6 +502,14 @@ void ComputerControlInterface::setMinimumFramebufferUpdateInterval()
 
 
 
+bool ComputerControlInterface::skipsFramebufferUpdates() const
+{
+	return m_framebufferUpdatesSuspended && m_framebufferUsers.isEmpty() &&
+		   (m_updateMode == UpdateMode::Basic || m_updateMode == UpdateMode::Monitoring);
+}
+
+
+
 void ComputerControlInterface::setQuality()
 {
 	auto quality = VncConnectionConfiguration::Quality::Highest;
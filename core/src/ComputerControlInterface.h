@@ -108,6 +108,15 @@ public:
 
 	QImage framebuffer() const;
 
+	// requests a fresh frame if framebuffer updates have been suspended so far and returns true in this case -
+	// the framebuffer then is current once scaledFramebufferUpdated() has been emitted and isFramebufferOutdated()
+	// returns false (requires the framebuffer to be marked as in use via setFramebufferInUse())
+	bool refreshFramebuffer();
+	bool isFramebufferOutdated() const
+	{
+		return m_framebufferOutdated;
+	}
+
 	int timestamp() const
 	{
 		return m_timestamp;
@@ -189,6 +198,16 @@ public:
 		return m_updateMode;
 	}
 
+	// skip framebuffer updates in Basic and Monitoring mode, e.g. while not visible in any view
+	void setFramebufferUpdatesSuspended( bool suspended );
+	bool areFramebufferUpdatesSuspended() const
+	{
+		return m_framebufferUpdatesSuspended;
+	}
+
+	// keeps framebuffer updates running despite suspension while the framebuffer is used, e.g. by a feature or model
+	void setFramebufferInUse( const QObject* user, bool inUse );
+
 	void setProperty(QUuid propertyId, const QVariant& data);
 
 	QVariant queryProperty(QUuid propertyId);
@@ -209,6 +228,7 @@ public:
 private:
 	void ping();
 	void setMinimumFramebufferUpdateInterval();
+	bool skipsFramebufferUpdates() const;
 	void setQuality();
 	void resetWatchdog();
 	void restartConnection();
@@ -231,6 +251,9 @@ private:
 	const int m_port;
 
 	UpdateMode m_updateMode{UpdateMode::Disabled};
+	bool m_framebufferUpdatesSuspended{false};
+	bool m_framebufferOutdated{false};
+	QSet<const QObject *> m_framebufferUsers;
 	Computer::NameSource m_computerNameSource{Computer::NameSource::Default};
 
 	State m_state{State::Disconnected};
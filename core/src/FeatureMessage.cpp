@@ -22,6 +22,8 @@
  *
  */
 
+#include <QBuffer>
+
 #include "FeatureManager.h"
 #include "FeatureMessage.h"
 #include "VariantArrayMessage.h"
@@ -35,7 +37,18 @@ bool FeatureMessage::sendPlain(QIODevice* ioDevice) const
 
 		message.write( m_featureUid );
 		message.write( m_command );
-		message.write( m_arguments );
+
+		const auto compressedArgs = compressedArguments();
+		if (compressedArgs.isEmpty())
+		{
+			message.write( m_arguments );
+		}
+		else
+		{
+			// older receivers just see an empty argument map and ignore the trailing data
+			message.write(Arguments{});
+			message.write(compressedArgs);
+		}
 
 		return message.send();
 	}
@@ -83,6 +96,15 @@ bool FeatureMessage::receive( QIODevice* ioDevice )
 			m_featureUid = message.read().toUuid(); // Flawfinder: ignore
 			m_command = message.read().value<Command>(); // Flawfinder: ignore
 			m_arguments = message.read().toMap(); // Flawfinder: ignore
+			m_compressedArguments.reset( new CompressedArguments );
+
+			if (message.atEnd() == false &&
+				uncompressArguments(message.read().toByteArray()) == false) // Flawfinder: ignore
+			{
+				vWarning() << "could not uncompress message arguments!";
+				return false;
+			}
+
 			return true;
 		}
 
@@ -98,6 +120,91 @@ bool FeatureMessage::receive( QIODevice* ioDevice )
 
 
 
+QByteArray FeatureMessage::compressedArguments() const
+{
+	if (m_compressionAllowed == false || m_arguments.isEmpty())
+	{
+		return {};
+	}
+
+	QMutexLocker locker(&m_compressedArguments->mutex);
+
+	if (m_compressedArguments->valid == false)
+	{
+		m_compressedArguments->data = compressArguments();
+		m_compressedArguments->valid = true;
+	}
+
+	return m_compressedArguments->data;
+}
+
+
+
+QByteArray FeatureMessage::compressArguments() const
+{
+	QBuffer buffer;
+	buffer.open(QBuffer::WriteOnly); // Flawfinder: ignore
+	VariantStream{&buffer}.write(m_arguments);
+
+	const auto& data = buffer.data();
+	if (data.size() < CompressionThreshold || data.size() > VariantStream::MaxByteArraySize)
+	{
+		return {};
+	}
+
+	auto compressedData = qCompress(data);
+
+	// skip compression for incompressible data such as images or archives
+	if (compressedData.size() * 100 > data.size() * CompressionRatioPercentage)
+	{
+		return {};
+	}
+
+	return compressedData;
+}
+
+
+
+bool FeatureMessage::uncompressArguments(const QByteArray& compressedArguments)
+{
+	static constexpr auto SizeHeaderLength = 4;
+
+	if (compressedArguments.size() < SizeHeaderLength)
+	{
+		return false;
+	}
+
+	// qCompress() prepends the uncompressed size in big endian byte order - reject
+	// oversized data before allocating any memory for it
+	const auto uncompressedSize = qFromBigEndian<quint32>(compressedArguments.constData());
+	if (uncompressedSize > quint32(VariantStream::MaxByteArraySize))
+	{
+		vWarning() << "invalid uncompressed arguments size" << uncompressedSize;
+		return false;
+	}
+
+	auto data = qUncompress(compressedArguments);
+	if (data.isEmpty())
+	{
+		return false;
+	}
+
+	QBuffer buffer(&data);
+	buffer.open(QBuffer::ReadOnly); // Flawfinder: ignore
+
+	const auto arguments = VariantStream{&buffer}.read(); // Flawfinder: ignore
+	if (arguments.userType() != QMetaType::QVariantMap)
+	{
+		return false;
+	}
+
+	m_arguments = arguments.toMap();
+
+	return true;
+}
+
+
+
 QDebug operator<<(QDebug stream, const FeatureMessage& message)
 {
 	stream << QStringLiteral("FeatureMessage(%1,%2,%3)")
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QMutex>
+#include <QSharedPointer>
 #include <QVariant>
 
 #include "EnumHelper.h"
@@ -40,6 +42,11 @@ public:
 
 	static constexpr unsigned char RfbMessageType = 41;
 
+	// arguments smaller than this are never worth compressing
+	static constexpr int CompressionThreshold = 4096;
+	// only send compressed arguments if they shrink to at most 90 % of their original size
+	static constexpr int CompressionRatioPercentage = 90;
+
 	enum SpecialCommands
 	{
 		DefaultCommand = 0,
@@ -59,7 +66,9 @@ public:
 	explicit FeatureMessage( const FeatureMessage& other ) :
 		m_featureUid( other.featureUid() ),
 		m_command( other.command() ),
-		m_arguments( other.arguments() )
+		m_arguments( other.arguments() ),
+		m_compressionAllowed( other.isCompressionAllowed() ),
+		m_compressedArguments( other.m_compressedArguments )
 	{
 	}
 
@@ -70,6 +79,8 @@ public:
 		m_featureUid = other.featureUid();
 		m_command = other.command();
 		m_arguments = other.arguments();
+		m_compressionAllowed = other.isCompressionAllowed();
+		m_compressedArguments = other.m_compressedArguments;
 
 		return *this;
 	}
@@ -89,6 +100,18 @@ public:
 		return m_arguments;
 	}
 
+	bool isCompressionAllowed() const
+	{
+		return m_compressionAllowed;
+	}
+
+	// compressed messages can only be received by peers running Veyon 5.0 or newer
+	FeatureMessage& setCompressionAllowed(bool allowed)
+	{
+		m_compressionAllowed = allowed;
+		return *this;
+	}
+
 	template<typename T>
 	FeatureMessage& addArgument(T index, const QVariant& value)
 	{
@@ -96,6 +119,7 @@ public:
 		if (indexString.isEmpty() == false)
 		{
 			m_arguments[indexString] = value;
+			m_compressedArguments.reset( new CompressedArguments );
 		}
 		return *this;
 	}
@@ -114,9 +138,24 @@ public:
 	bool receive( QIODevice* ioDevice );
 
 private:
+	// compressed arguments are shared by all copies of a message so that messages sent to many
+	// computers are compressed only once - sendPlain() may be called from multiple threads
+	struct CompressedArguments
+	{
+		QMutex mutex{};
+		bool valid{false};
+		QByteArray data{};
+	};
+
+	QByteArray compressedArguments() const;
+	QByteArray compressArguments() const;
+	bool uncompressArguments(const QByteArray& compressedArguments);
+
 	FeatureUid m_featureUid{};
 	Command m_command{InvalidCommand};
 	Arguments m_arguments{};
+	bool m_compressionAllowed{false};
+	QSharedPointer<CompressedArguments> m_compressedArguments{new CompressedArguments};
 
 } ;
 
@@ -24,6 +24,8 @@
 
 #include <QCoreApplication>
 #include <QDir>
+#include <QLocalSocket>
+#include <QTcpSocket>
 #include <QThread>
 #include <QTimer>
 
@@ -33,6 +35,7 @@
 #include "VeyonConfiguration.h"
 #include "VeyonCore.h"
 #include "PlatformCoreFunctions.h"
+#include "PlatformNetworkFunctions.h"
 #include "PlatformUserFunctions.h"
 
 // clazy:excludeall=detaching-member
@@ -40,21 +43,47 @@
 FeatureWorkerManager::FeatureWorkerManager( VeyonServerInterface& server, QObject* parent ) :
 	QObject( parent ),
 	m_server( server ),
-	m_tcpServer( this )
+	m_tcpServer( this ),
+	m_localServer( this )
 {
 	connect( &m_tcpServer, &QTcpServer::newConnection,
 			 this, &FeatureWorkerManager::acceptConnection );
-
-	if( !m_tcpServer.listen( QHostAddress::LocalHost,
-							 static_cast<quint16>( VeyonCore::config().featureWorkerManagerPort() + VeyonCore::sessionId() ) ) )
+	connect( &m_localServer, &QLocalServer::newConnection,
+			 this, &FeatureWorkerManager::acceptLocalConnection );
+
+	// report latencies regularly so they can be inspected in the logs of a running service
+	connect( &m_latencyLogTimer, &QTimer::timeout, this, &FeatureWorkerManager::logLatencies );
+	m_latencyLogTimer.start( LatencyLogInterval );
+
+	// workers of all users have to be able to connect - access is restricted through peer credential checks
+#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+	// use abstract socket addresses on Linux so server and workers do not depend on a shared TMPDIR
+	m_localServer.setSocketOptions( QLocalServer::WorldAccessOption | QLocalServer::AbstractNamespaceOption );
+#else
+	m_localServer.setSocketOptions( QLocalServer::WorldAccessOption );
+#endif
+
+	QLocalServer::removeServer( localServerName() );
+	if( m_localServer.listen( localServerName() ) )
 	{
-		vCritical() << "can't listen on localhost!";
+		startStandbyWorker();
 	}
+	else
+	{
+		vWarning() << "can't listen on local socket" << localServerName() << m_localServer.errorString()
+				   << "– falling back to TCP";
 
-	auto pendingMessagesTimer = new QTimer( this );
-	connect( pendingMessagesTimer, &QTimer::timeout, this, &FeatureWorkerManager::sendPendingMessages );
-
-	pendingMessagesTimer->start( 100 );
+		// TCP peers can't be authenticated so only listen on TCP if the local socket is not available
+		if( m_tcpServer.listen( QHostAddress::LocalHost,
+								static_cast<quint16>( VeyonCore::config().featureWorkerManagerPort() + VeyonCore::sessionId() ) ) )
+		{
+			startStandbyWorker();
+		}
+		else
+		{
+			vCritical() << "can't listen on localhost!";
+		}
+	}
 }
 
 
@@ -62,12 +91,17 @@ FeatureWorkerManager::FeatureWorkerManager( VeyonServerInterface& server, QObjec
 FeatureWorkerManager::~FeatureWorkerManager()
 {
 	m_tcpServer.close();
+	m_localServer.close();
 
 	// properly shutdown all worker processes
 	while( m_workers.isEmpty() == false )
 	{
 		stopWorker( m_workers.firstKey() );
 	}
+
+	terminateWorker( m_standbyWorker );
+
+	logLatencies();
 }
 
 
@@ -82,32 +116,21 @@ bool FeatureWorkerManager::startManagedSystemWorker( Feature::Uid featureUid )
 
 	stopWorker( featureUid );
 
-	Worker worker;
-
-	worker.process = new QProcess;
-	worker.process->setProcessChannelMode( QProcess::ForwardedChannels );
-
-	connect( worker.process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-			 worker.process, &QProcess::deleteLater );
-
 	vDebug() << "Starting managed system worker for feature" << VeyonCore::featureManager().feature(featureUid).name();
-	if( qEnvironmentVariableIsSet("VEYON_VALGRIND_WORKERS") )
-	{
-		worker.process->start( QStringLiteral("valgrind"),
-							   { QStringLiteral("--error-limit=no"),
-								 QStringLiteral("--leak-check=full"),
-								 QStringLiteral("--show-leak-kinds=all"),
-								 QStringLiteral("--log-file=valgrind-%1.log").arg(VeyonCore::formattedUuid(featureUid)),
-								 VeyonCore::filesystem().workerFilePath(), featureUid.toString() } );
-	}
-	else
+
+	if( assignStandbyWorker( featureUid ) == false )
 	{
-		worker.process->start( VeyonCore::filesystem().workerFilePath(), { featureUid.toString() } );
+		Worker worker;
+		worker.process = startWorkerProcess( featureUid.toString() );
+		worker.startupTimer.start();
+
+		m_workersMutex.lock();
+		m_workers[featureUid] = worker;
+		m_workersMutex.unlock();
 	}
 
-	m_workersMutex.lock();
-	m_workers[featureUid] = worker;
-	m_workersMutex.unlock();
+	// have a worker ready for the next feature
+	startStandbyWorker();
 
 	return true;
 }
@@ -136,7 +159,7 @@ bool FeatureWorkerManager::startUnmanagedSessionWorker( Feature::Uid featureUid
 	}
 
 	const auto ret = VeyonCore::platform().coreFunctions().
-					 runProgramAsUser( VeyonCore::filesystem().workerFilePath(), { featureUid.toString() },
+					 runProgramAsUser( VeyonCore::filesystem().workerFilePath(), workerArguments( featureUid.toString() ),
 									   currentUser,
 									   VeyonCore::platform().coreFunctions().activeDesktopName() );
 	if( ret == false )
@@ -168,25 +191,7 @@ bool FeatureWorkerManager::stopWorker( Feature::Uid featureUid )
 	{
 		vDebug() << "Stopping worker for feature" << featureUid;
 
-		auto& worker = m_workers[featureUid];
-
-		if( worker.socket )
-		{
-			worker.socket->disconnect( this );
-			disconnect( worker.socket );
-
-			worker.socket->close();
-			worker.socket->deleteLater();
-		}
-
-		if( worker.process )
-		{
-			auto killTimer = new QTimer;
-			connect( killTimer, &QTimer::timeout, worker.process, &QProcess::terminate );
-			connect( killTimer, &QTimer::timeout, worker.process, &QProcess::kill );
-			connect( killTimer, &QTimer::timeout, killTimer, &QTimer::deleteLater );
-			killTimer->start( 5000 );
-		}
+		terminateWorker( m_workers[featureUid] );
 
 		m_workers.remove( featureUid );
 	}
@@ -242,6 +247,21 @@ bool FeatureWorkerManager::isWorkerRunning( Feature::Uid featureUid )
 
 
 
+QString FeatureWorkerManager::localServerName()
+{
+	const auto name = QStringLiteral("veyon-featureworkermanager-%1").arg( VeyonCore::config().featureWorkerManagerPort() +
+																		   VeyonCore::sessionId() );
+#if defined(Q_OS_LINUX) && QT_VERSION < QT_VERSION_CHECK(6, 2, 0)
+	// without abstract socket addresses the socket is a file which by default is created in QDir::tempPath() –
+	// use a fixed directory instead since workers in user sessions may have a different TMPDIR than the server
+	return QStringLiteral("/tmp/") + name;
+#else
+	return name;
+#endif
+}
+
+
+
 void FeatureWorkerManager::acceptConnection()
 {
 	vDebug() << "accepting connection";
@@ -258,40 +278,91 @@ void FeatureWorkerManager::acceptConnection()
 
 
 
-void FeatureWorkerManager::processConnection( QTcpSocket* socket )
+void FeatureWorkerManager::acceptLocalConnection()
 {
-	FeatureMessage message;
-	message.receive( socket );
+	auto socket = m_localServer.nextPendingConnection();
 
-	m_workersMutex.lock();
+	if( VeyonCore::platform().networkFunctions().isLocalSocketPeerTrusted(
+			PlatformNetworkFunctions::Socket( socket->socketDescriptor() ) ) == false )
+	{
+		vWarning() << "rejecting local connection from untrusted peer";
+		socket->abort();
+		socket->deleteLater();
+		return;
+	}
 
-	// set socket information
-	if( m_workers.contains( message.featureUid() ) )
+	vDebug() << "accepting local connection";
+
+	connect( socket, &QLocalSocket::readyRead,
+			 this, [=] () { processConnection( socket ); } );
+
+	connect( socket, &QLocalSocket::disconnected,
+			 this, [=] () { closeConnection( socket ); } );
+}
+
+
+
+void FeatureWorkerManager::processConnection( QIODevice* socket )
+{
+	FeatureMessage message;
+
+	// process all buffered messages as readyRead() is not emitted again for data already received
+	while( message.isReadyForReceive( socket ) )
 	{
-		if( m_workers[message.featureUid()].socket.isNull() )
+		if( message.receive( socket ) == false )
 		{
-			m_workers[message.featureUid()].socket = socket;
-			sendPendingMessages();
+			return;
 		}
 
-		m_workersMutex.unlock();
+		if( message.featureUid().isNull() )
+		{
+			if( message.command() == FeatureMessage::InitCommand &&
+				m_standbyWorker.process && m_standbyWorker.socket.isNull() )
+			{
+				vDebug() << "standby worker ready after" << m_standbyWorker.startupTimer.elapsed() << "ms";
+				m_standbyWorker.socket = socket;
+			}
+			continue;
+		}
+
+		m_workersMutex.lock();
 
-		if( message.command() >= 0 )
+		// set socket information
+		if( m_workers.contains( message.featureUid() ) )
 		{
-			VeyonCore::featureManager().handleFeatureMessageFromWorker(m_server, message);
+			auto& worker = m_workers[message.featureUid()];
+			if( worker.socket.isNull() )
+			{
+				vDebug() << "worker for feature" << message.featureUid()
+						 << "ready after" << worker.startupTimer.elapsed() << "ms";
+				worker.socket = socket;
+				sendPendingMessages();
+			}
+			else if( worker.roundTripTimer.isValid() )
+			{
+				m_roundTripLatencies.add( worker.roundTripTimer.elapsed() );
+				worker.roundTripTimer.invalidate();
+			}
+
+			m_workersMutex.unlock();
+
+			if( message.command() >= 0 )
+			{
+				VeyonCore::featureManager().handleFeatureMessageFromWorker(m_server, message);
+			}
 		}
-	}
-	else
-	{
-		m_workersMutex.unlock();
+		else
+		{
+			m_workersMutex.unlock();
 
-		vCritical() << "got data from non-existing worker!" << message.featureUid();
+			vCritical() << "got data from non-existing worker!" << message.featureUid();
+		}
 	}
 }
 
 
 
-void FeatureWorkerManager::closeConnection( QTcpSocket* socket )
+void FeatureWorkerManager::closeConnection( QIODevice* socket )
 {
 	m_workersMutex.lock();
 
@@ -321,7 +392,7 @@ void FeatureWorkerManager::sendMessage( const FeatureMessage& message )
 
 	if( m_workers.contains( message.featureUid() ) )
 	{
-		m_workers[message.featureUid()].pendingMessages.append( message );
+		m_workers[message.featureUid()].pendingMessages.append( PendingMessage{message} );
 	}
 	else
 	{
@@ -329,6 +400,16 @@ void FeatureWorkerManager::sendMessage( const FeatureMessage& message )
 	}
 
 	m_workersMutex.unlock();
+
+	// sockets must only be written from the thread they belong to
+	if( thread() == QThread::currentThread() )
+	{
+		sendPendingMessages();
+	}
+	else
+	{
+		QMetaObject::invokeMethod( this, &FeatureWorkerManager::sendPendingMessages, Qt::QueuedConnection );
+	}
 }
 
 
@@ -343,10 +424,182 @@ void FeatureWorkerManager::sendPendingMessages()
 
 		while( worker.socket && worker.pendingMessages.isEmpty() == false )
 		{
-			worker.pendingMessages.first().sendPlain(worker.socket);
+			const auto& pendingMessage = worker.pendingMessages.constFirst();
+			pendingMessage.message.sendPlain(worker.socket);
+			m_deliveryLatencies.add( pendingMessage.queueTimer.elapsed() );
 			worker.pendingMessages.removeFirst();
+			worker.roundTripTimer.start();
 		}
 	}
 
 	m_workersMutex.unlock();
 }
+
+
+
+QStringList FeatureWorkerManager::workerArguments( const QString& argument ) const
+{
+	// workers only connect via TCP if told so since the local socket is preferred and may just not be ready yet
+	if( m_tcpServer.isListening() )
+	{
+		return { argument, QLatin1String(TcpTransportArgument) };
+	}
+
+	return { argument };
+}
+
+
+
+QProcess* FeatureWorkerManager::startWorkerProcess( const QString& argument )
+{
+	auto process = new QProcess;
+	process->setProcessChannelMode( QProcess::ForwardedChannels );
+
+	connect( process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+			 process, &QProcess::deleteLater );
+
+	if( qEnvironmentVariableIsSet("VEYON_VALGRIND_WORKERS") )
+	{
+		const auto featureUid = Feature::Uid{argument};
+		const auto logName = featureUid.isNull() ? argument : VeyonCore::formattedUuid( featureUid );
+		process->start( QStringLiteral("valgrind"),
+						QStringList{ QStringLiteral("--error-limit=no"),
+						  QStringLiteral("--leak-check=full"),
+						  QStringLiteral("--show-leak-kinds=all"),
+						  QStringLiteral("--log-file=valgrind-%1.log").arg(logName),
+						  VeyonCore::filesystem().workerFilePath() } + workerArguments( argument ) );
+	}
+	else
+	{
+		process->start( VeyonCore::filesystem().workerFilePath(), workerArguments( argument ) );
+	}
+
+	return process;
+}
+
+
+
+void FeatureWorkerManager::startStandbyWorker()
+{
+	if( m_standbyWorker.process ||
+		VeyonCore::config().featureWorkerPreloadingEnabled() == false ||
+		qEnvironmentVariableIsSet("VEYON_VALGRIND_WORKERS") )
+	{
+		return;
+	}
+
+	vDebug() << "Starting standby worker";
+
+	auto process = startWorkerProcess( QLatin1String(StandbyWorkerArgument) );
+
+	// replace standby worker if it exits (e.g. crashes) before being assigned to a feature
+	connect( process, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+			 this, [this, process]() {
+		if( m_standbyWorker.process == process )
+		{
+			vWarning() << "standby worker exited unexpectedly - restarting in" << StandbyWorkerRestartInterval << "ms";
+			m_standbyWorker = Worker{};
+			QTimer::singleShot( StandbyWorkerRestartInterval, this, &FeatureWorkerManager::startStandbyWorker );
+		}
+	} );
+
+	m_standbyWorker = Worker{};
+	m_standbyWorker.process = process;
+	m_standbyWorker.startupTimer.start();
+}
+
+
+
+bool FeatureWorkerManager::assignStandbyWorker( Feature::Uid featureUid )
+{
+	// standby worker not running or not initialized yet?
+	if( m_standbyWorker.process.isNull() || m_standbyWorker.socket.isNull() )
+	{
+		return false;
+	}
+
+	vDebug() << "Assigning standby worker to feature" << featureUid;
+
+	// the worker confirms the assignment with an init message for the given feature which
+	// then makes processConnection() associate the socket with the new worker entry
+	FeatureMessage{featureUid, FeatureMessage::InitCommand}.sendPlain(m_standbyWorker.socket);
+
+	Worker worker;
+	worker.process = m_standbyWorker.process;
+	worker.startupTimer.start();
+
+	m_standbyWorker = Worker{};
+
+	m_workersMutex.lock();
+	m_workers[featureUid] = worker;
+	m_workersMutex.unlock();
+
+	return true;
+}
+
+
+
+void FeatureWorkerManager::terminateWorker( Worker& worker )
+{
+	if( worker.socket )
+	{
+		worker.socket->disconnect( this );
+		disconnect( worker.socket );
+
+		worker.socket->close();
+		worker.socket->deleteLater();
+	}
+
+	if( worker.process )
+	{
+		auto killTimer = new QTimer;
+		connect( killTimer, &QTimer::timeout, worker.process, &QProcess::terminate );
+		connect( killTimer, &QTimer::timeout, worker.process, &QProcess::kill );
+		connect( killTimer, &QTimer::timeout, killTimer, &QTimer::deleteLater );
+		killTimer->start( WorkerProcessKillTimeout );
+	}
+}
+
+
+
+void FeatureWorkerManager::logLatencies()
+{
+	const auto sampleCount = m_deliveryLatencies.sampleCount() + m_roundTripLatencies.sampleCount();
+
+	// skip report if no messages have been exchanged since the last one
+	if( sampleCount == m_loggedLatencySampleCount )
+	{
+		return;
+	}
+
+	m_loggedLatencySampleCount = sampleCount;
+
+	vDebug() << "delivery latencies:" << m_deliveryLatencies.toString()
+			 << "round trip latencies:" << m_roundTripLatencies.toString();
+}
+
+
+
+void FeatureWorkerManager::LatencyHistogram::add( qint64 latency )
+{
+	const auto it = std::find_if( BucketLimits.cbegin(), BucketLimits.cend(),
+								  [latency]( qint64 limit ) { return latency < limit; } );
+	++m_buckets[std::size_t(std::distance( BucketLimits.cbegin(), it ))];
+	++m_sampleCount;
+}
+
+
+
+QString FeatureWorkerManager::LatencyHistogram::toString() const
+{
+	QStringList buckets;
+	buckets.reserve( int(m_buckets.size()) );
+
+	for( std::size_t i = 0; i < BucketLimits.size(); ++i )
+	{
+		buckets.append( QStringLiteral("<%1ms:%2").arg( BucketLimits[i] ).arg( m_buckets[i] ) );
+	}
+	buckets.append( QStringLiteral(">=%1ms:%2").arg( BucketLimits.back() ).arg( m_buckets.back() ) );
+
+	return buckets.join( QLatin1Char(' ') );
+}
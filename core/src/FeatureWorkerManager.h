@@ -24,10 +24,14 @@
 
 #pragma once
 
+#include <array>
+
+#include <QElapsedTimer>
+#include <QLocalServer>
 #include <QPointer>
 #include <QProcess>
 #include <QTcpServer>
-#include <QTcpSocket>
+#include <QTimer>
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
 #include <QRecursiveMutex>
@@ -44,6 +48,11 @@ class VEYON_CORE_EXPORT FeatureWorkerManager : public QObject
 {
 	Q_OBJECT
 public:
+	static constexpr auto StandbyWorkerArgument = "standby";
+	static constexpr auto TcpTransportArgument = "tcp";
+
+	static QString localServerName();
+
 	FeatureWorkerManager( VeyonServerInterface& server, QObject* parent = nullptr );
 	~FeatureWorkerManager() override;
 
@@ -59,32 +68,87 @@ public:
 
 private:
 	void acceptConnection();
-	void processConnection( QTcpSocket* socket );
-	void closeConnection( QTcpSocket* socket );
+	void acceptLocalConnection();
+	void processConnection( QIODevice* socket );
+	void closeConnection( QIODevice* socket );
 
 	void sendMessage( const FeatureMessage& message );
 
 	void sendPendingMessages();
 
+	QStringList workerArguments( const QString& argument ) const;
+	QProcess* startWorkerProcess( const QString& argument );
+	void startStandbyWorker();
+	bool assignStandbyWorker( Feature::Uid featureUid );
+
 	static constexpr auto UnmanagedSessionProcessRetryInterval = 5000;
+	static constexpr auto WorkerProcessKillTimeout = 5000;
+	static constexpr auto StandbyWorkerRestartInterval = 5000;
+
+	class LatencyHistogram
+	{
+	public:
+		void add(qint64 latency);
+		QString toString() const;
+
+		int sampleCount() const
+		{
+			return m_sampleCount;
+		}
+
+	private:
+		// upper bucket limits in milliseconds plus one bucket for everything above
+		static constexpr std::array<qint64, 6> BucketLimits{ 1, 5, 10, 50, 100, 500 };
+		std::array<int, BucketLimits.size() + 1> m_buckets{};
+		int m_sampleCount{0};
+	};
+
+	void logLatencies();
+
+	static constexpr auto LatencyLogInterval = 60000;
 
 	VeyonServerInterface& m_server;
 	QTcpServer m_tcpServer;
+	QLocalServer m_localServer;
+
+	struct PendingMessage
+	{
+		explicit PendingMessage( const FeatureMessage& featureMessage ) :
+			message( featureMessage )
+		{
+			queueTimer.start();
+		}
+
+		FeatureMessage message;
+		QElapsedTimer queueTimer;
+	};
 
 	struct Worker
 	{
-		QPointer<QTcpSocket> socket;
+		QPointer<QIODevice> socket;
 		QPointer<QProcess> process;
-		QList<FeatureMessage> pendingMessages;
+		QList<PendingMessage> pendingMessages;
+		QElapsedTimer roundTripTimer;
+		QElapsedTimer startupTimer;
 	};
 
+	void terminateWorker( Worker& worker );
+
 	using WorkerMap = QMap<Feature::Uid, Worker>;
 	WorkerMap m_workers;
 
+	// fully initialized worker process without a feature which is assigned to the next managed system worker
+	Worker m_standbyWorker;
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
 	QRecursiveMutex m_workersMutex;
 #else
 	QMutex m_workersMutex{QMutex::Recursive};
 #endif
 
+	LatencyHistogram m_deliveryLatencies;
+	LatencyHistogram m_roundTripLatencies;
+	QTimer m_latencyLogTimer{this};
+	int m_loggedLatencySampleCount{0};
+
 } ;
@@ -146,6 +146,13 @@ QString Filesystem::screenshotDirectoryPath() const
 
 
 
+QString Filesystem::cacheDirectoryPath() const
+{
+	return QStandardPaths::writableLocation( QStandardPaths::CacheLocation );
+}
+
+
+
 QString Filesystem::serviceFilePath() const
 {
 	return QDir::toNativeSeparators( QCoreApplication::applicationDirPath() + QDir::separator() +
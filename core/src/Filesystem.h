@@ -38,6 +38,7 @@ public:
 	bool ensurePathExists( const QString &path ) const;
 
 	QString screenshotDirectoryPath() const;
+	QString cacheDirectoryPath() const;
 
 	QString serviceFilePath() const;
 	QString serverFilePath() const;
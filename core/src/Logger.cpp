@@ -26,6 +26,7 @@
 #include <QDateTime>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 
 #include "VeyonConfiguration.h"
 #include "Filesystem.h"
@@ -104,6 +105,39 @@ Logger::~Logger()
 
 
 
+void Logger::setAppName( const QString& appName )
+{
+	const auto newAppName = QStringLiteral( "Veyon" ) + appName;
+
+	if( m_logFile == nullptr )
+	{
+		m_appName = newAppName;
+		return;
+	}
+
+	// open new log file without holding the log mutex as errors are logged as well
+	auto logFile = new QFile( QFileInfo( *m_logFile ).absoluteDir().filePath( QStringLiteral( "%1.log" ).arg( newAppName ) ) );
+	if( VeyonCore::platform().filesystemFunctions().openFileSafely(
+			logFile,
+			QFile::WriteOnly | QFile::Append | QFile::Unbuffered | QFile::Text,
+			QFile::ReadOwner | QFile::WriteOwner ) == false )
+	{
+		vCritical() << logFile->fileName() << "is a symlink and will not be written to for security reasons";
+		delete logFile;
+		return;
+	}
+
+	QMutexLocker l( &m_logMutex );
+
+	m_appName = newAppName;
+
+	m_logFile->close();
+	delete m_logFile;
+	m_logFile = logFile;
+}
+
+
+
 Logger::LogLevel Logger::logLevelFromString(const QString& logLevelString)
 {
 	if (logLevelString.startsWith(QLatin1String("debug")))
@@ -72,6 +72,9 @@ public:
 
 	static LogLevel logLevelFromString(const QString& logLevelString);
 
+	// continues logging to the log file of given application name, e.g. once a standby worker has been assigned
+	void setAppName( const QString& appName );
+
 private:
 	void initLogFile();
 	void openLogFile();
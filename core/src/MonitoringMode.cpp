@@ -106,7 +106,10 @@ void MonitoringMode::setMinimumFramebufferUpdateInterval(const ComputerControlIn
 
 void MonitoringMode::queryApplicationVersion(const ComputerControlInterfaceList& computerControlInterfaces)
 {
-	sendFeatureMessage(FeatureMessage{m_queryApplicationVersionFeature.uid()}, computerControlInterfaces);
+	// let the server know our version as well so it can send replies in newer formats
+	sendFeatureMessage(FeatureMessage{m_queryApplicationVersionFeature.uid()}
+					   .addArgument(Argument::ApplicationVersion, int(VeyonCore::config().applicationVersion())),
+					   computerControlInterfaces);
 }
 
 
@@ -243,6 +246,13 @@ bool MonitoringMode::handleFeatureMessage(VeyonServerInterface& server,
 
 	if (message.featureUid() == m_queryApplicationVersionFeature.uid())
 	{
+		// older clients do not send their version
+		const auto clientVersion = message.argument(Argument::ApplicationVersion);
+		if (clientVersion.isValid())
+		{
+			server.setClientApplicationVersion(messageContext, clientVersion.value<VeyonCore::ApplicationVersion>());
+		}
+
 		server.sendFeatureMessageReply(messageContext,
 									   FeatureMessage{m_queryApplicationVersionFeature.uid()}
 									   .addArgument(Argument::ApplicationVersion, int(VeyonCore::config().applicationVersion())));
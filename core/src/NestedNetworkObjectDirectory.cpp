@@ -35,6 +35,9 @@ NestedNetworkObjectDirectory::NestedNetworkObjectDirectory( QObject* parent ) :
 void NestedNetworkObjectDirectory::addSubDirectory( NetworkObjectDirectory* subDirectory )
 {
 	m_subDirectories.append( subDirectory );
+
+	connect( subDirectory, &NetworkObjectDirectory::objectsFetched, this,
+			 [=]( NetworkObject::ModelId parentId ) { updateSubDirectoryObjects( subDirectory, parentId ); } );
 }
 
 
@@ -74,13 +77,10 @@ void NestedNetworkObjectDirectory::update()
 	for( auto* subDirectory : std::as_const(m_subDirectories) )
 	{
 		subDirectoryNames.append( subDirectory->name() );
-		NetworkObject subDirectoryObject{this, NetworkObject::Type::SubDirectory, subDirectory->name(), {},
-											{}, rootObject().uid() };
-		addOrUpdateObject( subDirectoryObject, rootObject() );
 
 		subDirectory->update();
 
-		replaceObjectsRecursively( subDirectory, subDirectoryObject );
+		mirrorSubDirectory( subDirectory );
 	}
 
 	removeObjects( rootObject(), [subDirectoryNames]( const NetworkObject& object ) {
@@ -106,6 +106,58 @@ void NestedNetworkObjectDirectory::fetchObjects( const NetworkObject& parent )
 
 
 
+void NestedNetworkObjectDirectory::enableSnapshot()
+{
+	// snapshots are maintained by the sub directories which own the actual objects
+	for( auto* subDirectory : std::as_const(m_subDirectories) )
+	{
+		subDirectory->enableSnapshot();
+		mirrorSubDirectory( subDirectory );
+	}
+}
+
+
+
+void NestedNetworkObjectDirectory::mirrorSubDirectory( NetworkObjectDirectory* subDirectory )
+{
+	const NetworkObject subDirectoryObject{this, NetworkObject::Type::SubDirectory, subDirectory->name(), {},
+										   {}, rootObject().uid() };
+	addOrUpdateObject( subDirectoryObject, rootObject() );
+
+	replaceObjectsRecursively( subDirectory, subDirectoryObject );
+}
+
+
+
+void NestedNetworkObjectDirectory::updateSubDirectoryObjects( NetworkObjectDirectory* subDirectory,
+															   NetworkObject::ModelId parentId )
+{
+	if( parentId == subDirectory->rootId() )
+	{
+		const auto subDirectoryObjects = objects( rootObject() );
+		for( const auto& subDirectoryObject : subDirectoryObjects )
+		{
+			if( subDirectoryObject.type() == NetworkObject::Type::SubDirectory &&
+				subDirectoryObject.name() == subDirectory->name() )
+			{
+				replaceObjectsRecursively( subDirectory, subDirectoryObject );
+				break;
+			}
+		}
+	}
+	else
+	{
+		// objects of sub directories are mirrored with identical UIDs and thus model IDs
+		const auto parent = object( this->parentId( parentId ), parentId );
+		if( parent.isValid() )
+		{
+			replaceObjectsRecursively( subDirectory, parent );
+		}
+	}
+}
+
+
+
 void NestedNetworkObjectDirectory::replaceObjectsRecursively( NetworkObjectDirectory* directory,
 															   const NetworkObject& parent )
 {
@@ -113,7 +165,9 @@ void NestedNetworkObjectDirectory::replaceObjectsRecursively( NetworkObjectDirec
 												 ? directory->rootObject() : parent );
 	for( const auto& object : objects )
 	{
-		if( object.isPopulated() && object.isContainer() )
+		// also mirror unpopulated containers with objects restored from a snapshot
+		if( object.isContainer() &&
+			( object.isPopulated() || directory->childCount( object.modelId() ) > 0 ) )
 		{
 			replaceObjectsRecursively( directory, object );
 		}
@@ -41,7 +41,11 @@ public:
 	void update() override;
 	void fetchObjects( const NetworkObject& parent ) override;
 
+	void enableSnapshot() override;
+
 private:
+	void mirrorSubDirectory( NetworkObjectDirectory* subDirectory );
+	void updateSubDirectoryObjects( NetworkObjectDirectory* subDirectory, NetworkObject::ModelId parentId );
 	void replaceObjectsRecursively( NetworkObjectDirectory* directory,
 								   const NetworkObject& parent );
 
@@ -34,12 +34,7 @@ const QUuid NetworkObject::networkObjectNamespace( QStringLiteral( "8a6c479e-243
 
 
 NetworkObject::NetworkObject( const NetworkObject& other ) :
-	m_directory( other.directory() ),
-	m_properties( other.properties() ),
-	m_type( other.type() ),
-	m_name( other.name() ),
-	m_uid( other.uid() ),
-	m_parentUid( other.parentUid() ),
+	m_data( other.m_data ),
 	m_populated( other.isPopulated() )
 {
 }
@@ -52,17 +47,18 @@ NetworkObject::NetworkObject( NetworkObjectDirectory* directory,
 							  const QVariantMap& properties,
 							  Uid uid,
 							  Uid parentUid ) :
-	m_directory( directory ),
-	m_properties( properties ),
-	m_type( type ),
-	m_name( name ),
-	m_uid( uid ),
-	m_parentUid( parentUid ),
-	m_populated( false )
+	m_data( new Data )
 {
-	if( m_uid.isNull() )
+	m_data->directory = directory;
+	m_data->properties = properties;
+	m_data->type = type;
+	m_data->name = name;
+	m_data->uid = uid;
+	m_data->parentUid = parentUid;
+
+	if( m_data->uid.isNull() )
 	{
-		m_uid = calculateUid();
+		m_data->uid = calculateUid();
 		m_calculatedUid = true;
 	}
 }
@@ -70,31 +66,22 @@ NetworkObject::NetworkObject( NetworkObjectDirectory* directory,
 
 
 NetworkObject::NetworkObject( const QJsonObject& jsonObject, NetworkObjectDirectory* directory ) :
-	m_directory( directory ),
-	m_properties( jsonObject.toVariantMap() ),
-	m_type( Type( jsonObject.value( propertyKey( Property::Type ) ).toInt() ) ),
-	m_name( jsonObject.value( propertyKey( Property::Name ) ).toString() ),
-	m_uid( jsonObject.value( propertyKey( Property::Uid ) ).toString() ),
-	m_parentUid( jsonObject.value( propertyKey( Property::ParentUid ) ).toString() ),
-	m_populated( false )
+	m_data( new Data )
 {
+	m_data->directory = directory;
+	m_data->properties = jsonObject.toVariantMap();
+	m_data->type = Type( jsonObject.value( propertyKey( Property::Type ) ).toInt() );
+	m_data->name = jsonObject.value( propertyKey( Property::Name ) ).toString();
+	m_data->uid = Uid( jsonObject.value( propertyKey( Property::Uid ) ).toString() );
+	m_data->parentUid = Uid( jsonObject.value( propertyKey( Property::ParentUid ) ).toString() );
 }
 
 
 
 NetworkObject& NetworkObject::operator=( const NetworkObject& other )
 {
-	if( this == &other )
-	{
-		return *this;
-	}
-
-	m_directory = other.directory();
-	m_type = other.type();
-	m_name = other.name();
-	m_uid = other.uid();
-	m_parentUid = other.parentUid();
-	m_properties = other.properties();
+	// the populated state belongs to the object in the directory and thus is not assigned
+	m_data = other.m_data;
 
 	return *this;
 }
@@ -110,6 +97,11 @@ bool NetworkObject::operator==( const NetworkObject& other ) const
 
 bool NetworkObject::exactMatch( const NetworkObject& other ) const
 {
+	if( m_data == other.m_data )
+	{
+		return true;
+	}
+
 	return directory() == other.directory() &&
 			uid() == other.uid() &&
 			type() == other.type() &&
@@ -122,11 +114,11 @@ bool NetworkObject::exactMatch( const NetworkObject& other ) const
 
 void NetworkObject::setParentUid( Uid parentUid )
 {
-	m_parentUid = parentUid;
+	m_data->parentUid = parentUid;
 
 	if( m_calculatedUid )
 	{
-		m_uid = calculateUid();
+		m_data->uid = calculateUid();
 	}
 }
 
@@ -160,21 +152,32 @@ QVariant NetworkObject::property( Property property ) const
 {
 	switch( property )
 	{
-	case Property::Type: return QVariant::fromValue(m_type);
-	case Property::Name: return m_name;
-	case Property::Uid: return m_uid;
-	case Property::ParentUid: return m_parentUid;
+	case Property::Type: return QVariant::fromValue(type());
+	case Property::Name: return name();
+	case Property::Uid: return uid();
+	case Property::ParentUid: return parentUid();
 	default: break;
 	}
 
-	return m_properties.value( propertyKey(property) );
+	return properties().value( propertyKey(property) );
 }
 
 
 
 QString NetworkObject::propertyKey( Property property )
 {
-	return EnumHelper::toString(property);
+	// share key strings between the property maps of all objects
+	static const auto propertyKeys = []() {
+		QHash<int, QString> keys;
+		const auto metaEnum = QMetaEnum::fromType<Property>();
+		for( int i = 0; i < metaEnum.keyCount(); ++i )
+		{
+			keys[metaEnum.value(i)] = EnumHelper::toString( Property(metaEnum.value(i)) );
+		}
+		return keys;
+	}();
+
+	return propertyKeys.value( int(property) );
 }
 
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include <QSharedData>
 #include <QUuid>
 #include <QString>
 
@@ -84,7 +85,7 @@ public:
 
 	NetworkObjectDirectory* directory() const
 	{
-		return m_directory;
+		return m_data->directory;
 	}
 
 	bool isValid() const
@@ -104,12 +105,12 @@ public:
 
 	const Uid& uid() const
 	{
-		return m_uid;
+		return m_data->uid;
 	}
 
 	const Uid& parentUid() const
 	{
-		return m_parentUid;
+		return m_data->parentUid;
 	}
 
 	void setParentUid( Uid parentUid );
@@ -118,7 +119,7 @@ public:
 
 	Type type() const
 	{
-		return m_type;
+		return m_data->type;
 	}
 
 	bool isContainer() const
@@ -135,12 +136,12 @@ public:
 
 	const Name& name() const
 	{
-		return m_name;
+		return m_data->name;
 	}
 
 	const Properties& properties() const
 	{
-		return m_properties;
+		return m_data->properties;
 	}
 
 	QVariant property( Property property ) const;
@@ -153,13 +154,20 @@ public:
 private:
 	Uid calculateUid() const;
 
-	NetworkObjectDirectory* m_directory;
-	Properties m_properties;
-	Type m_type;
-	QString m_name;
-	Uid m_uid;
-	Uid m_parentUid;
-	bool m_populated;
+	// attributes are implicitly shared so copying objects between directories, models and
+	// lists only costs a single reference count operation
+	struct Data : public QSharedData
+	{
+		NetworkObjectDirectory* directory{nullptr};
+		Properties properties{};
+		Type type{Type::None};
+		Name name{};
+		Uid uid{};
+		Uid parentUid{};
+	};
+
+	QSharedDataPointer<Data> m_data;
+	bool m_populated{false};
 	bool m_calculatedUid{false};
 
 	static const QUuid networkObjectNamespace;
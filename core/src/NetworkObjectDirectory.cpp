@@ -22,9 +22,15 @@
  *
  */
 
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
 #include <QTimer>
 
+#include "Filesystem.h"
+#include "HostAddress.h"
 #include "NetworkObjectDirectory.h"
+#include "NetworkObjectDirectorySnapshot.h"
 
 
 NetworkObjectDirectory::NetworkObjectDirectory( const QString& name, QObject* parent ) :
@@ -101,6 +107,19 @@ const NetworkObject& NetworkObjectDirectory::object( NetworkObject::ModelId pare
 
 
 
+const NetworkObject& NetworkObjectDirectory::object( NetworkObject::Uid objectUid ) const
+{
+	const auto it = m_objectIdsByUid.constFind( objectUid );
+	if( it != m_objectIdsByUid.constEnd() )
+	{
+		return object( parentId( *it ), *it );
+	}
+
+	return m_invalidObject;
+}
+
+
+
 int NetworkObjectDirectory::index( NetworkObject::ModelId parent, NetworkObject::ModelId child ) const
 {
 	const auto it = m_objects.constFind( parent );
@@ -158,20 +177,7 @@ NetworkObject::ModelId NetworkObjectDirectory::parentId( NetworkObject::ModelId
 		return 0;
 	}
 
-	for( auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it )
-	{
-		const auto& objectList = it.value();
-
-		for( const auto& object : objectList )
-		{
-			if( object.modelId() == child )
-			{
-				return it.key();
-			}
-		}
-	}
-
-	return 0;
+	return m_parentIds.value( child, 0 );
 }
 
 
@@ -185,16 +191,13 @@ NetworkObject::ModelId NetworkObjectDirectory::rootId() const
 
 QVariant NetworkObjectDirectory::queryObjectProperty(NetworkObject::Uid objectUid, NetworkObject::Property property)
 {
-	for( auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it )
+	const auto it = m_objectIdsByUid.constFind(objectUid);
+	if (it != m_objectIdsByUid.constEnd())
 	{
-		const auto& objectList = it.value();
-
-		for( const auto& object : objectList )
+		const auto& object = this->object(parentId(*it), *it);
+		if (object.isValid())
 		{
-			if (object.uid() == objectUid)
-			{
-				return object.property(property);
-			}
+			return object.property(property);
 		}
 	}
 
@@ -212,17 +215,67 @@ NetworkObjectList NetworkObjectDirectory::queryObjects( NetworkObject::Type type
 		update();
 	}
 
+	const auto matches = [&]( const NetworkObject& object ) {
+		return ( type == NetworkObject::Type::None || object.type() == type ) &&
+			   ( property == NetworkObject::Property::None ||
+				 object.isPropertyValueEqual( property, value, Qt::CaseInsensitive ) );
+	};
+
 	NetworkObjectList objects;
 
+	QList<NetworkObject::ModelId> candidateIds;
+	auto useIndex = true;
+
+	if( property == NetworkObject::Property::Name && value.userType() == QMetaType::QString )
+	{
+		candidateIds = m_objectIdsByName.values( indexKey( value ) );
+	}
+	else if( property == NetworkObject::Property::HostAddress && value.userType() == QMetaType::QString )
+	{
+		candidateIds = objectIdsByHostAddress( value.toString() );
+	}
+	else if( property == NetworkObject::Property::Uid && value.userType() == qMetaTypeId<NetworkObject::Uid>() )
+	{
+		const auto it = m_objectIdsByUid.constFind( value.value<NetworkObject::Uid>() );
+		if( it != m_objectIdsByUid.constEnd() )
+		{
+			candidateIds.append( *it );
+		}
+	}
+	else if( property == NetworkObject::Property::None && type != NetworkObject::Type::None )
+	{
+		const auto objectIds = m_objectIdsByType.value( int(type) );
+		candidateIds = { objectIds.begin(), objectIds.end() };
+	}
+	else
+	{
+		useIndex = false;
+	}
+
+	if( useIndex )
+	{
+		for( const auto objectId : std::as_const(candidateIds) )
+		{
+			for( auto it = m_parentIds.constFind( objectId ); it != m_parentIds.constEnd() && it.key() == objectId; ++it )
+			{
+				const auto& object = this->object( it.value(), objectId );
+				if( object.isValid() && matches( object ) )
+				{
+					objects.append( object );
+				}
+			}
+		}
+
+		return objects;
+	}
+
 	for( auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it )
 	{
 		const auto& objectList = it.value();
 
 		for( const auto& object : objectList )
 		{
-			if( ( type == NetworkObject::Type::None || object.type() == type ) &&
-				( property == NetworkObject::Property::None ||
-				  object.isPropertyValueEqual( property, value, Qt::CaseInsensitive ) ) )
+			if( matches( object ) )
 			{
 				objects.append( object );
 			}
@@ -246,16 +299,13 @@ NetworkObjectList NetworkObjectDirectory::queryParents( const NetworkObject& chi
 		return {};
 	}
 
-	for( auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it )
+	const auto it = m_objectIdsByUid.constFind( child.parentUid() );
+	if( it != m_objectIdsByUid.constEnd() )
 	{
-		const auto& objectList = it.value();
-
-		for( const auto& object : objectList )
+		const auto& object = this->object( parentId( *it ), *it );
+		if( object.isValid() )
 		{
-			if( object.uid() == child.parentUid() )
-			{
-				return queryParents( object ) + NetworkObjectList( { object } );
-			}
+			return queryParents( object ) + NetworkObjectList( { object } );
 		}
 	}
 
@@ -277,6 +327,39 @@ void NetworkObjectDirectory::fetchObjects( const NetworkObject& object )
 
 
 
+void NetworkObjectDirectory::enableSnapshot()
+{
+	if( m_saveSnapshotTimer )
+	{
+		return;
+	}
+
+	const auto cacheDirectoryPath = VeyonCore::filesystem().cacheDirectoryPath();
+	if( cacheDirectoryPath.isEmpty() )
+	{
+		return;
+	}
+
+	const auto nameHash = QCryptographicHash::hash( m_name.toUtf8(), QCryptographicHash::Sha1 ).toHex().left( 16 );
+	m_snapshotFilePath = QDir( cacheDirectoryPath ).filePath( QStringLiteral( "NetworkObjectDirectory-%1.snapshot" )
+																   .arg( QString::fromLatin1( nameHash ) ) );
+
+	loadSnapshot();
+
+	m_saveSnapshotTimer = new QTimer( this );
+	m_saveSnapshotTimer->setInterval( SnapshotSaveDelay );
+	m_saveSnapshotTimer->setSingleShot( true );
+	connect( m_saveSnapshotTimer, &QTimer::timeout, this, &NetworkObjectDirectory::saveSnapshot );
+
+	// coalesce all modifications of an update into a single snapshot
+	const auto scheduleSnapshot = [this]() { m_saveSnapshotTimer->start(); };
+	connect( this, &NetworkObjectDirectory::objectsInserted, this, scheduleSnapshot );
+	connect( this, &NetworkObjectDirectory::objectsRemoved, this, scheduleSnapshot );
+	connect( this, &NetworkObjectDirectory::objectsChanged, this, scheduleSnapshot );
+}
+
+
+
 bool NetworkObjectDirectory::hasObjects() const
 {
 	return m_objects.size() > 1;
@@ -306,7 +389,8 @@ void NetworkObjectDirectory::addOrUpdateObject( const NetworkObject& networkObje
 		Q_EMIT objectsAboutToBeInserted(parent.modelId(), objectList.count(), 1);
 
 		objectList.append( completeNetworkObject );
-		if( completeNetworkObject.isContainer() )
+		addToIndexes( completeNetworkObject, parent.modelId() );
+		if( completeNetworkObject.isContainer() && m_objects.contains( completeNetworkObject.modelId() ) == false )
 		{
 			m_objects[completeNetworkObject.modelId()] = {};
 		}
@@ -317,7 +401,9 @@ void NetworkObjectDirectory::addOrUpdateObject( const NetworkObject& networkObje
 	}
 	else if( objectList[index].exactMatch( completeNetworkObject ) == false )
 	{
+		removeFromIndexes( objectList[index], parent.modelId() );
 		objectList.replace( index, completeNetworkObject );
+		addToIndexes( completeNetworkObject, parent.modelId() );
 		propagateChildObjectChange(parent.modelId());
 	}
 }
@@ -332,33 +418,51 @@ void NetworkObjectDirectory::removeObjects( const NetworkObject& parent, const N
 	}
 
 	auto& objectList = m_objects[parent.modelId()]; // clazy:exclude=detaching-member
-	int index = 0;
 	QList<NetworkObject::ModelId> objectsToRemove;
 
-	for( auto it = objectList.begin(); it != objectList.end(); )
+	// remove contiguous ranges of matching objects at once, starting at the end so
+	// that indexes of ranges not processed yet remain valid
+	for( int last = objectList.count() - 1; last >= 0; )
 	{
-		if( removeObjectFilter( *it ) )
+		if( removeObjectFilter( objectList[last] ) == false )
 		{
-			if( it->isContainer() )
-			{
-				objectsToRemove.append( it->modelId() );
-			}
+			--last;
+			continue;
+		}
 
-			Q_EMIT objectsAboutToBeRemoved(parent.modelId(), index, 1);
-			it = objectList.erase( it );
-			Q_EMIT objectsRemoved();
-			propagateChildObjectChange(parent.modelId());
+		auto first = last;
+		while( first > 0 && removeObjectFilter( objectList[first-1] ) )
+		{
+			--first;
 		}
-		else
+
+		Q_EMIT objectsAboutToBeRemoved(parent.modelId(), first, last - first + 1);
+
+		for( int index = first; index <= last; ++index )
 		{
-			++it;
-			++index;
+			const auto& object = objectList[index];
+			if( object.isContainer() )
+			{
+				objectsToRemove.append( object.modelId() );
+			}
+			removeFromIndexes( object, parent.modelId() );
 		}
+
+		objectList.erase( objectList.begin() + first, objectList.begin() + last + 1 );
+
+		Q_EMIT objectsRemoved();
+		propagateChildObjectChange(parent.modelId());
+
+		last = first - 1;
 	}
 
 	for( const auto& groupId : objectsToRemove )
 	{
-		m_objects.remove( groupId );
+		// keep children of containers which still are listed somewhere else
+		if( m_parentIds.contains( groupId ) == false )
+		{
+			removeObjectTree( groupId );
+		}
 	}
 }
 
@@ -366,12 +470,130 @@ void NetworkObjectDirectory::removeObjects( const NetworkObject& parent, const N
 
 void NetworkObjectDirectory::replaceObjects( const NetworkObjectList& objects, const NetworkObject& parent )
 {
+	if( m_objects.contains( parent.modelId() ) == false )
+	{
+		vCritical() << "parent" << parent.toJson() << "does not exist";
+		return;
+	}
+
+	QSet<NetworkObject::Uid> objectUids;
+	objectUids.reserve( objects.count() );
+
+	for( const auto& object : objects )
+	{
+		objectUids.insert( object.uid() );
+	}
+
+	removeObjects( parent, [&objectUids]( const NetworkObject& object ) {
+		return objectUids.contains( object.uid() ) == false; } );
+
+	addOrUpdateObjects( objects, parent );
+}
+
+
+
+void NetworkObjectDirectory::addOrUpdateObjects( const NetworkObjectList& objects, const NetworkObject& parent )
+{
+	const auto parentId = parent.modelId();
+
+	if( m_objects.contains( parentId ) == false )
+	{
+		vCritical() << "parent" << parent.toJson() << "does not exist";
+		return;
+	}
+
+	QHash<NetworkObject::Uid, int> newObjectIndexes;
+	newObjectIndexes.reserve( objects.count() );
+
+	NetworkObjectList newObjects;
+	newObjects.reserve( objects.count() );
+
 	for( const auto& object : objects )
 	{
-		addOrUpdateObject( object, parent );
+		if( newObjectIndexes.contains( object.uid() ) == false )
+		{
+			newObjectIndexes[object.uid()] = newObjects.count();
+			newObjects.append( object );
+			if( newObjects.last().parentUid().isNull() )
+			{
+				newObjects.last().setParentUid( parent.uid() );
+			}
+		}
+	}
+
+	auto& objectList = m_objects[parentId]; // clazy:exclude=detaching-member
+	auto modified = false;
+
+	// update existing objects and announce changes as contiguous ranges
+	QVector<bool> existingObjects( newObjects.count(), false );
+	int firstChanged = -1;
+
+	for( int index = 0; index <= objectList.count(); ++index )
+	{
+		auto changed = false;
+
+		const auto newObjectIndex = index < objectList.count() ? newObjectIndexes.value( objectList[index].uid(), -1 ) : -1;
+		if( newObjectIndex >= 0 )
+		{
+			const auto& newObject = newObjects[newObjectIndex];
+			existingObjects[newObjectIndex] = true;
+
+			if( objectList[index].exactMatch( newObject ) == false )
+			{
+				removeFromIndexes( objectList[index], parentId );
+				objectList.replace( index, newObject );
+				addToIndexes( newObject, parentId );
+				changed = true;
+			}
+		}
+
+		if( changed && firstChanged < 0 )
+		{
+			firstChanged = index;
+		}
+		else if( changed == false && firstChanged >= 0 )
+		{
+			Q_EMIT objectsChanged( parentId, firstChanged, index - firstChanged );
+			firstChanged = -1;
+			modified = true;
+		}
+	}
+
+	// append all new objects at once
+	NetworkObjectList objectsToInsert;
+	for( int i = 0; i < newObjects.count(); ++i )
+	{
+		if( existingObjects[i] == false )
+		{
+			objectsToInsert.append( newObjects[i] );
+		}
 	}
 
-	removeObjects( parent, [&objects]( const NetworkObject& object ) { return objects.contains( object ) == false; } );
+	if( objectsToInsert.isEmpty() == false )
+	{
+		Q_EMIT objectsAboutToBeInserted( parentId, objectList.count(), objectsToInsert.count() );
+
+		objectList.append( objectsToInsert );
+
+		// objectList must not be accessed anymore once new containers got added to m_objects
+		for( const auto& object : std::as_const(objectsToInsert) )
+		{
+			addToIndexes( object, parentId );
+			if( object.isContainer() && m_objects.contains( object.modelId() ) == false )
+			{
+				m_objects[object.modelId()] = {};
+			}
+		}
+
+		Q_EMIT objectsInserted();
+
+		modified = true;
+	}
+
+	if( modified )
+	{
+		propagateChildObjectChange( parentId );
+	}
 }
 
 
@@ -427,8 +649,174 @@ void NetworkObjectDirectory::propagateChildObjectChanges()
 		const auto parentObjectId = parentId(*it);
 		const auto childIndex = index(parentObjectId, *it);
 
-		Q_EMIT objectChanged(parentObjectId, childIndex);
+		Q_EMIT objectsChanged(parentObjectId, childIndex, 1);
 	}
 
 	m_changedObjectIds.clear();
 }
+
+
+
+void NetworkObjectDirectory::addToIndexes( const NetworkObject& object, NetworkObject::ModelId parentId )
+{
+	const auto objectId = object.modelId();
+
+	m_parentIds.insert( objectId, parentId );
+	m_objectIdsByUid[object.uid()] = objectId;
+	m_objectIdsByType[int(object.type())].insert( objectId );
+
+	const auto nameKey = indexKey( object.name() );
+	if( m_objectIdsByName.contains( nameKey, objectId ) == false )
+	{
+		m_objectIdsByName.insert( nameKey, objectId );
+	}
+
+	const auto hostAddress = object.property( NetworkObject::Property::HostAddress );
+	if( hostAddress.userType() == QMetaType::QString )
+	{
+		auto& objectIds = m_objectIdsByHostAddress[int(HostAddress(hostAddress.toString()).type())];
+		const auto hostAddressKey = indexKey( hostAddress );
+		if( objectIds.contains( hostAddressKey, objectId ) == false )
+		{
+			objectIds.insert( hostAddressKey, objectId );
+		}
+	}
+}
+
+
+
+void NetworkObjectDirectory::removeFromIndexes( const NetworkObject& object, NetworkObject::ModelId parentId )
+{
+	const auto objectId = object.modelId();
+
+	m_parentIds.remove( objectId, parentId );
+
+	// other instances of the object still need all index entries
+	if( m_parentIds.contains( objectId ) )
+	{
+		return;
+	}
+
+	m_objectIdsByUid.remove( object.uid() );
+	m_objectIdsByType[int(object.type())].remove( objectId );
+	m_objectIdsByName.remove( indexKey( object.name() ), objectId );
+
+	const auto hostAddress = object.property( NetworkObject::Property::HostAddress );
+	if( hostAddress.userType() == QMetaType::QString )
+	{
+		m_objectIdsByHostAddress[int(HostAddress(hostAddress.toString()).type())].remove( indexKey( hostAddress ), objectId );
+	}
+}
+
+
+
+void NetworkObjectDirectory::removeObjectTree( NetworkObject::ModelId containerId )
+{
+	const auto children = m_objects.take( containerId );
+
+	for( const auto& child : children )
+	{
+		removeFromIndexes( child, containerId );
+
+		if( child.isContainer() && m_parentIds.contains( child.modelId() ) == false )
+		{
+			removeObjectTree( child.modelId() );
+		}
+	}
+}
+
+
+
+QList<NetworkObject::ModelId> NetworkObjectDirectory::objectIdsByHostAddress( const QString& hostAddress ) const
+{
+	QList<NetworkObject::ModelId> objectIds;
+
+	// convert the address into each format used by indexed objects once,
+	// the same way NetworkObject::isPropertyValueEqual() does per object
+	const HostAddress address( hostAddress );
+
+	for( auto it = m_objectIdsByHostAddress.constBegin(), end = m_objectIdsByHostAddress.constEnd(); it != end; ++it )
+	{
+		if( it->isEmpty() == false )
+		{
+			objectIds += it->values( indexKey( address.convert( HostAddress::Type(it.key()) ) ) );
+		}
+	}
+
+	return objectIds;
+}
+
+
+
+void NetworkObjectDirectory::loadSnapshot()
+{
+	NetworkObjectList objects;
+	if( NetworkObjectDirectorySnapshot::load( m_snapshotFilePath, this, objects ) == false )
+	{
+		return;
+	}
+
+	QHash<NetworkObject::Uid, NetworkObjectList> objectsByParentUid;
+	for( const auto& object : std::as_const(objects) )
+	{
+		objectsByParentUid[object.parentUid()].append( object );
+	}
+
+	// restored containers are not marked as populated so their contents get refreshed when fetched
+	NetworkObjectList parents{rootObject()};
+	for( int i = 0; i < parents.count(); ++i )
+	{
+		const auto parent = parents[i];
+		const auto children = objectsByParentUid.take( parent.uid() );
+		if( children.isEmpty() == false )
+		{
+			addOrUpdateObjects( children, parent );
+
+			for( const auto& child : children )
+			{
+				if( child.isContainer() )
+				{
+					parents.append( child );
+				}
+			}
+		}
+	}
+
+	vDebug() << "restored" << objects.count() << "objects of directory" << m_name;
+}
+
+
+
+void NetworkObjectDirectory::saveSnapshot() const
+{
+	NetworkObjectList objects;
+	QSet<NetworkObject::ModelId> visitedParentIds;
+
+	QList<NetworkObject::ModelId> parentIds{rootId()};
+	for( int i = 0; i < parentIds.count(); ++i )
+	{
+		const auto children = m_objects.value( parentIds[i] );
+		for( const auto& child : children )
+		{
+			objects.append( child );
+
+			if( m_objects.contains( child.modelId() ) && visitedParentIds.contains( child.modelId() ) == false )
+			{
+				visitedParentIds.insert( child.modelId() );
+				parentIds.append( child.modelId() );
+			}
+		}
+	}
+
+	if( VeyonCore::filesystem().ensurePathExists( QFileInfo( m_snapshotFilePath ).path() ) )
+	{
+		NetworkObjectDirectorySnapshot::save( m_snapshotFilePath, objects );
+	}
+}
+
+
+
+QString NetworkObjectDirectory::indexKey( const QVariant& value )
+{
+	return value.toString().toCaseFolded();
+}
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QHash>
+#include <QSet>
 #include <QObject>
 
 #include "NetworkObject.h"
@@ -53,6 +54,7 @@ public:
 	const NetworkObjectList& objects( const NetworkObject& parent ) const;
 
 	const NetworkObject& object( NetworkObject::ModelId parent, NetworkObject::ModelId object ) const;
+	const NetworkObject& object( NetworkObject::Uid objectUid ) const;
 	int index( NetworkObject::ModelId parent, NetworkObject::ModelId child ) const;
 	int childCount( NetworkObject::ModelId parent ) const;
 	NetworkObject::ModelId childId( NetworkObject::ModelId parent, int index ) const;
@@ -73,11 +75,15 @@ public:
 	virtual void update() = 0;
 	virtual void fetchObjects( const NetworkObject& object );
 
+	// restores objects from the last snapshot (if any) and stores a new snapshot whenever objects change
+	virtual void enableSnapshot();
+
 protected:
 	using NetworkObjectFilter = std::function<bool (const NetworkObject &)>;
 
 	bool hasObjects() const;
 	void addOrUpdateObject( const NetworkObject& networkObject, const NetworkObject& parent );
+	void addOrUpdateObjects( const NetworkObjectList& objects, const NetworkObject& parent );
 	void removeObjects( const NetworkObject& parent, const NetworkObjectFilter& removeObjectFilter );
 	void replaceObjects( const NetworkObjectList& objects, const NetworkObject& parent );
 	void setObjectPopulated( const NetworkObject& networkObject );
@@ -86,21 +92,41 @@ protected:
 
 private:
 	static constexpr auto ObjectChangePropagationTimeout = 100;
+	static constexpr auto SnapshotSaveDelay = 5000;
+
+	void addToIndexes( const NetworkObject& object, NetworkObject::ModelId parentId );
+	void removeFromIndexes( const NetworkObject& object, NetworkObject::ModelId parentId );
+	void removeObjectTree( NetworkObject::ModelId containerId );
+	QList<NetworkObject::ModelId> objectIdsByHostAddress( const QString& hostAddress ) const;
+	static QString indexKey( const QVariant& value );
+	void loadSnapshot();
+	void saveSnapshot() const;
 
 	const QString m_name;
 	QTimer* m_updateTimer = nullptr;
 	QTimer* m_propagateChangedObjectsTimer = nullptr;
+	QTimer* m_saveSnapshotTimer = nullptr;
+	QString m_snapshotFilePath;
 	QHash<NetworkObject::ModelId, NetworkObjectList> m_objects{};
 	NetworkObject m_invalidObject{this, NetworkObject::Type::None};
 	NetworkObject m_rootObject{this, NetworkObject::Type::Root};
 	NetworkObjectList m_defaultObjectList{};
 	QList<NetworkObject::ModelId> m_changedObjectIds;
 
+	// secondary indexes maintained by addOrUpdateObject() and removeObjects() - an object
+	// can be listed more than once if it's a child of multiple parents
+	QMultiHash<NetworkObject::ModelId, NetworkObject::ModelId> m_parentIds{};
+	QHash<NetworkObject::Uid, NetworkObject::ModelId> m_objectIdsByUid{};
+	QHash<int, QSet<NetworkObject::ModelId>> m_objectIdsByType{};
+	QMultiHash<QString, NetworkObject::ModelId> m_objectIdsByName{};
+	QHash<int, QMultiHash<QString, NetworkObject::ModelId>> m_objectIdsByHostAddress{}; // keyed by HostAddress::Type
+
 Q_SIGNALS:
 	void objectsAboutToBeInserted(NetworkObject::ModelId parentId, int index, int count);
 	void objectsInserted();
 	void objectsAboutToBeRemoved(NetworkObject::ModelId parentId, int index, int count);
 	void objectsRemoved();
-	void objectChanged(NetworkObject::ModelId parentId, int index);
+	void objectsChanged(NetworkObject::ModelId parentId, int index, int count);
+	void objectsFetched(NetworkObject::ModelId parentId); // emitted when asynchronously fetching objects has finished
 
 };
@@ -0,0 +1,288 @@
+/*
+ * NetworkObjectDirectorySnapshot.cpp - implementation of NetworkObjectDirectorySnapshot
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <cstring>
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QMetaEnum>
+#include <QSaveFile>
+
+#include "NetworkObjectDirectorySnapshot.h"
+#include "VariantStream.h"
+
+
+const char NetworkObjectDirectorySnapshot::Magic[4] = { 'V', 'N', 'O', 'S' };
+
+
+template<typename T>
+static void appendRecords( QByteArray& data, const QVector<T>& records )
+{
+	data.append( reinterpret_cast<const char *>( records.constData() ), int( records.size() * sizeof(T) ) );
+}
+
+
+
+template<typename T>
+static T readRecord( const char* data, quint64 offset )
+{
+	// mapped data is not necessarily aligned suitably
+	T record;
+	std::memcpy( &record, data + offset, sizeof(T) );
+	return record;
+}
+
+
+
+bool NetworkObjectDirectorySnapshot::save( const QString& filePath, const NetworkObjectList& objects )
+{
+	QHash<QByteArray, quint32> stringIndexes;
+	QVector<StringRecord> strings;
+	QHash<QByteArray, quint32> valueIndexes;
+	QVector<StringRecord> values;
+	QByteArray data;
+
+	const auto addData = [&data]( QHash<QByteArray, quint32>& indexes, QVector<StringRecord>& records,
+								  const QByteArray& bytes ) -> quint32 {
+		const auto it = indexes.constFind( bytes );
+		if( it != indexes.constEnd() )
+		{
+			return it.value();
+		}
+
+		const auto index = quint32( records.size() );
+		records.append( { quint32( data.size() ), quint32( bytes.size() ) } );
+		data.append( bytes );
+		indexes[bytes] = index;
+		return index;
+	};
+
+	const auto addString = [&]( const QString& string ) -> quint32 {
+		return addData( stringIndexes, strings, string.toUtf8() );
+	};
+
+	const auto addValue = [&]( const QVariant& value ) -> quint32 {
+		QBuffer buffer;
+		buffer.open( QBuffer::WriteOnly ); // Flawfinder: ignore
+		VariantStream{&buffer}.write( value );
+		return addData( valueIndexes, values, buffer.data() );
+	};
+
+	QVector<ObjectRecord> objectRecords;
+	objectRecords.reserve( objects.size() );
+	QVector<PropertyRecord> propertyRecords;
+
+	for( const auto& object : objects )
+	{
+		ObjectRecord record{};
+		std::memcpy( record.uid, object.uid().toRfc4122().constData(), sizeof(record.uid) );
+		std::memcpy( record.parentUid, object.parentUid().toRfc4122().constData(), sizeof(record.parentUid) );
+		record.type = quint32( object.type() );
+		record.name = addString( object.name() );
+		record.firstProperty = quint32( propertyRecords.size() );
+
+		const auto properties = object.properties();
+		for( auto it = properties.constBegin(), end = properties.constEnd(); it != end; ++it )
+		{
+			propertyRecords.append( { addString( it.key() ), addValue( it.value() ) } );
+		}
+
+		record.propertyCount = quint32( propertyRecords.size() ) - record.firstProperty;
+		objectRecords.append( record );
+	}
+
+	QByteArray payload;
+	appendRecords( payload, strings );
+	appendRecords( payload, values );
+	appendRecords( payload, objectRecords );
+	appendRecords( payload, propertyRecords );
+	payload.append( data );
+
+	Header header{};
+	std::memcpy( header.magic, Magic, sizeof(header.magic) );
+	header.version = Version;
+	header.stringCount = quint32( strings.size() );
+	header.objectCount = quint32( objectRecords.size() );
+	header.propertyCount = quint32( propertyRecords.size() );
+	header.valueCount = quint32( values.size() );
+	header.payloadSize = quint64( payload.size() );
+
+	const auto checksum = QCryptographicHash::hash( payload, QCryptographicHash::Sha256 );
+	std::memcpy( header.checksum, checksum.constData(), sizeof(header.checksum) );
+
+	// write to a temporary file first so that an interrupted write never leaves a truncated snapshot
+	QSaveFile file( filePath );
+	if( file.open( QFile::WriteOnly ) == false ||
+		file.write( reinterpret_cast<const char *>( &header ), sizeof(header) ) != sizeof(header) ||
+		file.write( payload ) != payload.size() )
+	{
+		vWarning() << "failed to write network object directory snapshot" << filePath << file.errorString();
+		return false;
+	}
+
+	return file.commit();
+}
+
+
+
+bool NetworkObjectDirectorySnapshot::load( const QString& filePath, NetworkObjectDirectory* directory,
+										   NetworkObjectList& objects )
+{
+	QFile file( filePath );
+	if( file.exists() == false || file.open( QFile::ReadOnly ) == false )
+	{
+		return false;
+	}
+
+	const auto size = file.size();
+	const auto data = size > 0 ? file.map( 0, size ) : nullptr;
+
+	const auto valid = data && decode( reinterpret_cast<const char *>( data ), size, directory, objects );
+
+	if( data )
+	{
+		file.unmap( data );
+	}
+	file.close();
+
+	if( valid == false )
+	{
+		vWarning() << "discarding invalid network object directory snapshot" << filePath;
+		objects.clear();
+		QFile::remove( filePath );
+	}
+
+	return valid;
+}
+
+
+
+bool NetworkObjectDirectorySnapshot::decode( const char* data, qint64 size, NetworkObjectDirectory* directory,
+											 NetworkObjectList& objects )
+{
+	if( size < qint64( sizeof(Header) ) )
+	{
+		return false;
+	}
+
+	const auto header = readRecord<Header>( data, 0 );
+	if( std::memcmp( header.magic, Magic, sizeof(Magic) ) != 0 ||
+		header.version != Version ||
+		header.payloadSize != quint64( size ) - sizeof(Header) )
+	{
+		return false;
+	}
+
+	const auto payload = data + sizeof(Header);
+
+	const auto valuesOffset = quint64( header.stringCount ) * sizeof(StringRecord);
+	const auto objectsOffset = valuesOffset + quint64( header.valueCount ) * sizeof(StringRecord);
+	const auto propertiesOffset = objectsOffset + quint64( header.objectCount ) * sizeof(ObjectRecord);
+	const auto dataOffset = propertiesOffset + quint64( header.propertyCount ) * sizeof(PropertyRecord);
+	if( dataOffset > header.payloadSize )
+	{
+		return false;
+	}
+
+	const auto checksum = QCryptographicHash::hash( QByteArray::fromRawData( payload, int( header.payloadSize ) ),
+													QCryptographicHash::Sha256 );
+	if( checksum.size() != sizeof(header.checksum) ||
+		std::memcmp( checksum.constData(), header.checksum, sizeof(header.checksum) ) != 0 )
+	{
+		return false;
+	}
+
+	const auto dataSize = header.payloadSize - dataOffset;
+
+	QStringList strings;
+	strings.reserve( int( header.stringCount ) );
+
+	for( quint32 i = 0; i < header.stringCount; ++i )
+	{
+		const auto record = readRecord<StringRecord>( payload, i * sizeof(StringRecord) );
+		if( quint64( record.offset ) + record.size > dataSize )
+		{
+			return false;
+		}
+		strings.append( QString::fromUtf8( payload + dataOffset + record.offset, int( record.size ) ) );
+	}
+
+	QVariantList values;
+	values.reserve( int( header.valueCount ) );
+
+	for( quint32 i = 0; i < header.valueCount; ++i )
+	{
+		const auto record = readRecord<StringRecord>( payload, valuesOffset + i * sizeof(StringRecord) );
+		if( quint64( record.offset ) + record.size > dataSize )
+		{
+			return false;
+		}
+
+		auto valueData = QByteArray::fromRawData( payload + dataOffset + record.offset, int( record.size ) );
+		QBuffer buffer( &valueData );
+		buffer.open( QBuffer::ReadOnly ); // Flawfinder: ignore
+
+		const auto value = VariantStream{&buffer}.read(); // Flawfinder: ignore
+		if( value.isValid() == false )
+		{
+			return false;
+		}
+		values.append( value );
+	}
+
+	const auto typeEnum = QMetaEnum::fromType<NetworkObject::Type>();
+
+	objects.clear();
+	objects.reserve( int( header.objectCount ) );
+
+	for( quint32 i = 0; i < header.objectCount; ++i )
+	{
+		const auto record = readRecord<ObjectRecord>( payload, objectsOffset + i * sizeof(ObjectRecord) );
+		if( typeEnum.valueToKey( int( record.type ) ) == nullptr ||
+			record.name >= header.stringCount ||
+			quint64( record.firstProperty ) + record.propertyCount > header.propertyCount )
+		{
+			return false;
+		}
+
+		NetworkObject::Properties properties;
+		for( quint32 j = 0; j < record.propertyCount; ++j )
+		{
+			const auto property = readRecord<PropertyRecord>( payload, propertiesOffset +
+															  ( quint64( record.firstProperty ) + j ) * sizeof(PropertyRecord) );
+			if( property.key >= header.stringCount || property.value >= header.valueCount )
+			{
+				return false;
+			}
+			properties[strings[int( property.key )]] = values[int( property.value )];
+		}
+
+		objects.append( NetworkObject{ directory, NetworkObject::Type( record.type ), strings[int( record.name )], properties,
+									   QUuid::fromRfc4122( QByteArray::fromRawData( record.uid, sizeof(record.uid) ) ),
+									   QUuid::fromRfc4122( QByteArray::fromRawData( record.parentUid, sizeof(record.parentUid) ) ) } );
+	}
+
+	return true;
+}
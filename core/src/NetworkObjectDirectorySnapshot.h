@@ -0,0 +1,89 @@
+/*
+ * NetworkObjectDirectorySnapshot.h - header file for NetworkObjectDirectorySnapshot
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include "NetworkObject.h"
+
+// compact binary representation of the objects of a network object directory which is stored
+// in the cache directory and memory-mapped when loading it - the file layout is
+//
+//   Header | StringRecord[] (strings) | StringRecord[] (values) | ObjectRecord[] | PropertyRecord[] | data
+//
+// where names and keys are stored as UTF-8 strings and property values are serialized through VariantStream
+// so they keep their types, with all integers in host byte order since snapshots are never shared between machines
+class VEYON_CORE_EXPORT NetworkObjectDirectorySnapshot
+{
+public:
+	static constexpr quint32 Version = 2;
+
+	// objects have to be ordered such that parents precede their children
+	static bool save( const QString& filePath, const NetworkObjectList& objects );
+
+	// returns false and removes the file if it is invalid, outdated or corrupted
+	static bool load( const QString& filePath, NetworkObjectDirectory* directory, NetworkObjectList& objects );
+
+private:
+	struct Header
+	{
+		char magic[4];
+		quint32 version;
+		quint32 stringCount;
+		quint32 objectCount;
+		quint32 propertyCount;
+		quint32 valueCount;
+		quint64 payloadSize;
+		char checksum[32];
+	};
+
+	struct StringRecord
+	{
+		quint32 offset;
+		quint32 size;
+	};
+
+	struct ObjectRecord
+	{
+		char uid[16];
+		char parentUid[16];
+		quint32 type;
+		quint32 name;
+		quint32 firstProperty;
+		quint32 propertyCount;
+	};
+
+	struct PropertyRecord
+	{
+		quint32 key;
+		quint32 value;
+	};
+
+	static_assert( sizeof(Header) == 64, "unexpected padding in snapshot header" );
+	static_assert( sizeof(ObjectRecord) == 48, "unexpected padding in snapshot object record" );
+
+	static bool decode( const char* data, qint64 size, NetworkObjectDirectory* directory, NetworkObjectList& objects );
+
+	static const char Magic[4];
+
+};
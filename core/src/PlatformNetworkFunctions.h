@@ -52,6 +52,14 @@ public:
 
 	virtual bool configureSocketKeepalive( Socket socket, bool enabled, int idleTime, int interval, int probes ) = 0;
 
+	// checks whether the process connected to a local (Unix domain) socket runs as privileged
+	// user, as the same user as this process or as the user logged on in the current session
+	virtual bool isLocalSocketPeerTrusted( Socket socket ) = 0;
+
+	// checks whether the server a local socket has been connected to runs as privileged user or as the
+	// same user as this process, so that other users can't impersonate it by creating the socket first
+	virtual bool isLocalSocketServerTrusted( Socket socket ) = 0;
+
 	virtual QNetworkInterface defaultRouteNetworkInterface() = 0;
 	virtual int networkInterfaceSpeedInMBitPerSecond(const QNetworkInterface& networkInterface) = 0;
 
@@ -47,11 +47,14 @@
 #endif
 
 QSGImageTexture::QSGImageTexture()
-	: m_texture_id(0)
+	: m_uploaded_format(QImage::Format_Invalid)
+	, m_external_format(GL_RGBA)
+	, m_texture_id(0)
 	, m_has_alpha(false)
 	, m_dirty_texture(false)
 	, m_dirty_bind_options(false)
 	, m_owns_texture(true)
+	, m_convert_to_rgba(false)
 {
 }
 
@@ -65,12 +68,30 @@ QSGImageTexture::~QSGImageTexture()
 void QSGImageTexture::setImage(const QImage &image)
 {
 	m_image = image;
+	m_source_rect = image.rect();
+	m_dirty_region = {};
 	m_texture_size = image.size();
 	m_has_alpha = image.hasAlphaChannel();
 	m_dirty_texture = true;
 	m_dirty_bind_options = true;
  }
 
+void QSGImageTexture::updateImage(const QImage &image, const QRect &sourceRect, const QRegion &dirtyRegion)
+{
+	const QRect rect = sourceRect.isValid() ? sourceRect.intersected(image.rect()) : image.rect();
+
+	if (m_dirty_texture || m_texture_id == 0 || rect != m_source_rect ||
+		rect.size() != m_uploaded_size || image.format() != m_uploaded_format) {
+		setImage(image);
+		m_source_rect = rect;
+		m_texture_size = rect.size();
+		return;
+	}
+
+	m_image = image;
+	m_dirty_region += dirtyRegion.intersected(QRect(QPoint(), rect.size()));
+}
+
 int QSGImageTexture::textureId() const
 {
 	if (m_dirty_texture) {
@@ -96,6 +117,8 @@ void QSGImageTexture::bind()
 		funcs->glBindTexture(GL_TEXTURE_2D, m_texture_id);
 		updateBindOptions(m_dirty_bind_options);
 		m_dirty_bind_options = false;
+		if (!m_dirty_region.isEmpty())
+			uploadDirtyRegion(funcs);
 		return;
 	}
 
@@ -107,6 +130,7 @@ void QSGImageTexture::bind()
 		}
 		m_texture_id = 0;
 		m_texture_size = QSize();
+		m_uploaded_size = QSize();
 		m_has_alpha = false;
 
 		return;
@@ -120,11 +144,19 @@ void QSGImageTexture::bind()
 				 ? m_image
 				 : m_image.convertToFormat(QImage::Format_ARGB32_Premultiplied);*/;
 
+	if (m_source_rect != tmp.rect())
+		tmp = tmp.copy(m_source_rect);
+
+	const QImage::Format sourceFormat = tmp.format();
+	m_uploaded_size = tmp.size();
+
 	int max;
 	funcs->glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max);
 	if (tmp.width() > max || tmp.height() > max) {
 		tmp = tmp.scaled(qMin(max, tmp.width()), qMin(max, tmp.height()), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
 		m_texture_size = tmp.size();
+		// partial uploads are not possible for scaled textures
+		m_uploaded_size = QSize();
 	}
 
 	if (tmp.width() * 4 != tmp.bytesPerLine())
@@ -170,7 +202,182 @@ void QSGImageTexture::bind()
 
 	funcs->glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_texture_size.width(), m_texture_size.height(), 0, externalFormat, GL_UNSIGNED_BYTE, tmp.constBits());
 
+	m_external_format = externalFormat;
+	m_convert_to_rgba = tmp.format() != sourceFormat;
+	m_uploaded_format = m_image.format();
+	m_dirty_region = {};
 	m_dirty_bind_options = false;
 	m_image = {};
 }
+
+void QSGImageTexture::uploadDirtyRegion(QOpenGLFunctions *funcs)
+{
+	if (m_image.isNull()) {
+		m_dirty_region = {};
+		return;
+	}
+
+	for (const QRect &rect : std::as_const(m_dirty_region)) {
+		QImage tmp = m_image.copy(rect.translated(m_source_rect.topLeft()));
+		if (m_convert_to_rgba)
+			tmp = std::move(tmp).convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+
+		funcs->glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x(), rect.y(), rect.width(), rect.height(), m_external_format, GL_UNSIGNED_BYTE, tmp.constBits());
+	}
+
+	m_dirty_region = {};
+	m_image = {};
+}
+#else
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+#include <rhi/qrhi.h>
+#else
+#include <QtGui/private/qrhi_p.h>
+#endif
+#include <QVarLengthArray>
+
+QSGImageTexture::~QSGImageTexture()
+{
+	delete m_texture;
+}
+
+qint64 QSGImageTexture::comparisonKey() const
+{
+	if (m_texture)
+		return qint64(qintptr(m_texture));
+
+	return qint64(qintptr(this));
+}
+
+void QSGImageTexture::setImage(const QImage &image)
+{
+	m_image = image;
+	m_source_rect = image.rect();
+	m_dirty_region = {};
+	m_texture_size = image.size();
+	m_has_alpha = image.hasAlphaChannel();
+	m_dirty_texture = true;
+}
+
+void QSGImageTexture::updateImage(const QImage &image, const QRect &sourceRect, const QRegion &dirtyRegion)
+{
+	const QRect rect = sourceRect.isValid() ? sourceRect.intersected(image.rect()) : image.rect();
+
+	if (m_dirty_texture || m_texture == nullptr || rect != m_source_rect ||
+		rect.size() != m_uploaded_size || image.format() != m_uploaded_format) {
+		setImage(image);
+		m_source_rect = rect;
+		m_texture_size = rect.size();
+		return;
+	}
+
+	m_image = image;
+	m_dirty_region += dirtyRegion.intersected(QRect(QPoint(), rect.size()));
+}
+
+void QSGImageTexture::commitTextureOperations(QRhi *rhi, QRhiResourceUpdateBatch *resourceUpdates)
+{
+	if (!m_dirty_texture) {
+		if (!m_dirty_region.isEmpty())
+			uploadDirtyRegion(resourceUpdates);
+		return;
+	}
+
+	m_dirty_texture = false;
+
+	if (m_image.isNull()) {
+		if (m_texture)
+			m_texture->deleteLater();
+		m_texture = nullptr;
+		m_texture_size = QSize();
+		m_uploaded_size = QSize();
+		m_has_alpha = false;
+
+		return;
+	}
+
+	QImage tmp = m_image;
+	QRect sourceRect = m_source_rect;
+
+	m_uploaded_size = sourceRect.size();
+
+	const int max = rhi->resourceLimit(QRhi::TextureSizeMax);
+	if (sourceRect.width() > max || sourceRect.height() > max) {
+		tmp = tmp.copy(sourceRect).scaled(qMin(max, sourceRect.width()), qMin(max, sourceRect.height()),
+										  Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+		sourceRect = tmp.rect();
+		m_texture_size = tmp.size();
+		// partial uploads are not possible for scaled textures
+		m_uploaded_size = QSize();
+	}
+
+	// 32 bit (A)RGB images can be uploaded as-is as BGRA on little endian systems
+	QRhiTexture::Format textureFormat = QRhiTexture::BGRA8;
+	m_convert_to_rgba = Q_BYTE_ORDER != Q_LITTLE_ENDIAN ||
+			(tmp.format() != QImage::Format_RGB32 && tmp.format() != QImage::Format_ARGB32_Premultiplied) ||
+			rhi->isTextureFormatSupported(QRhiTexture::BGRA8) == false;
+	if (m_convert_to_rgba) {
+		textureFormat = QRhiTexture::RGBA8;
+		tmp = tmp.copy(sourceRect).convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+		sourceRect = tmp.rect();
+	}
+
+	if (m_texture == nullptr || m_texture->pixelSize() != m_texture_size || m_texture->format() != textureFormat) {
+		// the texture might still be in use by the frame being recorded
+		if (m_texture)
+			m_texture->deleteLater();
+		m_texture = rhi->newTexture(textureFormat, m_texture_size);
+		if (m_texture->create() == false) {
+			qWarning("QSGImageTexture: failed to create texture of size %dx%d", m_texture_size.width(), m_texture_size.height());
+			delete m_texture;
+			m_texture = nullptr;
+			m_uploaded_size = QSize();
+			m_image = {};
+			return;
+		}
+	}
+
+	QRhiTextureSubresourceUploadDescription subresource(tmp);
+	subresource.setSourceTopLeft(sourceRect.topLeft());
+	subresource.setSourceSize(sourceRect.size());
+	resourceUpdates->uploadTexture(m_texture, QRhiTextureUploadDescription(QRhiTextureUploadEntry(0, 0, subresource)));
+
+	m_uploaded_format = m_image.format();
+	m_dirty_region = {};
+	m_image = {};
+}
+
+void QSGImageTexture::uploadDirtyRegion(QRhiResourceUpdateBatch *resourceUpdates)
+{
+	if (m_image.isNull() || m_texture == nullptr) {
+		m_dirty_region = {};
+		return;
+	}
+
+	QVarLengthArray<QRhiTextureUploadEntry, 16> entries;
+
+	for (const QRect &rect : std::as_const(m_dirty_region)) {
+		const QRect sourceRect = rect.translated(m_source_rect.topLeft());
+
+		if (m_convert_to_rgba) {
+			QRhiTextureSubresourceUploadDescription subresource(
+				m_image.copy(sourceRect).convertToFormat(QImage::Format_RGBA8888_Premultiplied));
+			subresource.setDestinationTopLeft(rect.topLeft());
+			entries.append(QRhiTextureUploadEntry(0, 0, subresource));
+		} else {
+			QRhiTextureSubresourceUploadDescription subresource(m_image);
+			subresource.setSourceTopLeft(sourceRect.topLeft());
+			subresource.setSourceSize(sourceRect.size());
+			subresource.setDestinationTopLeft(rect.topLeft());
+			entries.append(QRhiTextureUploadEntry(0, 0, subresource));
+		}
+	}
+
+	QRhiTextureUploadDescription description;
+	description.setEntries(entries.cbegin(), entries.cend());
+	resourceUpdates->uploadTexture(m_texture, description);
+
+	m_dirty_region = {};
+	m_image = {};
+}
 #endif
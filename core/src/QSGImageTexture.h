@@ -40,9 +40,12 @@
 #pragma once
 
 #include <QImage>
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+#include <QRegion>
 #include <QSGTexture>
 
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+class QOpenGLFunctions;
+
 class QSGImageTexture : public QSGTexture
 {
 	Q_OBJECT
@@ -65,6 +68,10 @@ public:
 	void setImage(const QImage &image);
 	const QImage &image() { return m_image; }
 
+	// uploads sourceRect of image, restricted to dirtyRegion (relative to sourceRect)
+	// if the texture already holds an earlier version of the same area
+	void updateImage(const QImage &image, const QRect &sourceRect, const QRegion &dirtyRegion);
+
 	void bind() override;
 
 	static QSGImageTexture *fromImage(const QImage &image) {
@@ -74,7 +81,15 @@ public:
 	}
 
 protected:
+	void uploadDirtyRegion(QOpenGLFunctions *funcs);
+
 	QImage m_image;
+	QRect m_source_rect;
+	QRegion m_dirty_region;
+
+	QSize m_uploaded_size;
+	QImage::Format m_uploaded_format;
+	uint m_external_format;
 
 	uint m_texture_id;
 	QSize m_texture_size;
@@ -83,6 +98,56 @@ protected:
 	uint m_dirty_texture : 1;
 	uint m_dirty_bind_options : 1;
 	uint m_owns_texture : 1;
+	uint m_convert_to_rgba : 1;
+};
+
+#else
+class QRhiTexture;
+
+class QSGImageTexture : public QSGTexture
+{
+	Q_OBJECT
+public:
+	QSGImageTexture() = default;
+	~QSGImageTexture() override;
+
+	qint64 comparisonKey() const override;
+	QRhiTexture *rhiTexture() const override { return m_texture; }
+	QSize textureSize() const override { return m_texture_size; }
+	bool hasAlphaChannel() const override { return m_has_alpha; }
+	bool hasMipmaps() const override { return false; }
+
+	void setImage(const QImage &image);
+	const QImage &image() { return m_image; }
+
+	// uploads sourceRect of image, restricted to dirtyRegion (relative to sourceRect)
+	// if the texture already holds an earlier version of the same area
+	void updateImage(const QImage &image, const QRect &sourceRect, const QRegion &dirtyRegion);
+
+	void commitTextureOperations(QRhi *rhi, QRhiResourceUpdateBatch *resourceUpdates) override;
+
+	static QSGImageTexture *fromImage(const QImage &image) {
+		QSGImageTexture *t = new QSGImageTexture();
+		t->setImage(image);
+		return t;
+	}
+
+protected:
+	void uploadDirtyRegion(QRhiResourceUpdateBatch *resourceUpdates);
+
+	QImage m_image;
+	QRect m_source_rect;
+	QRegion m_dirty_region;
+
+	QSize m_uploaded_size;
+	QImage::Format m_uploaded_format = QImage::Format_Invalid;
+
+	QRhiTexture *m_texture = nullptr;
+	QSize m_texture_size;
+
+	bool m_has_alpha = false;
+	bool m_dirty_texture = false;
+	bool m_convert_to_rgba = false;
 };
 
 #endif
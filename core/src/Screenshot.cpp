@@ -52,6 +52,9 @@ Screenshot::Screenshot( const QString &fileName, QObject* parent ) :
 
 void Screenshot::take( const ComputerControlInterface::Pointer& computerControlInterface )
 {
+	// fetch the image first so that it matches the date and time in the file name and caption
+	const auto framebuffer = computerControlInterface->framebuffer();
+
 	auto userLogin = computerControlInterface->userLoginName();
 	if( userLogin.isEmpty() )
 	{
@@ -104,7 +107,7 @@ void Screenshot::take( const ComputerControlInterface::Pointer& computerControlI
 
 	const auto caption = QStringLiteral( "%1@%2 %3 %4" ).arg( user, host, date, time );
 
-	m_image = computerControlInterface->framebuffer();
+	m_image = framebuffer;
 
 	QPixmap icon( QStringLiteral( ":/core/icon16.png" ) );
 
@@ -610,19 +610,34 @@ void VeyonCore::initConfiguration()
 
 
 
-void VeyonCore::initLogging( const QString& appComponentName )
+void VeyonCore::setAppComponentName( const QString& appComponentName )
+{
+	if( m_logger )
+	{
+		m_logger->setAppName( loggerAppName( appComponentName ) );
+	}
+}
+
+
+
+QString VeyonCore::loggerAppName( const QString& appComponentName )
 {
 	const auto currentSessionId = sessionId();
 
 	if( currentSessionId != PlatformSessionFunctions::DefaultSessionId )
 	{
-		m_logger = new Logger( QStringLiteral("%1-%2").arg( appComponentName ).arg( currentSessionId ) );
-	}
-	else
-	{
-		m_logger = new Logger( appComponentName );
+		return QStringLiteral("%1-%2").arg( appComponentName ).arg( currentSessionId );
 	}
 
+	return appComponentName;
+}
+
+
+
+void VeyonCore::initLogging( const QString& appComponentName )
+{
+	m_logger = new Logger( loggerAppName( appComponentName ) );
+
 	m_debugging = ( m_logger->logLevel() >= Logger::LogLevel::Debug );
 
 	VncConnection::initLogging( isDebugging() );
@@ -213,11 +213,14 @@ public:
 
 	int exec();
 
+	void setAppComponentName( const QString& appComponentName );
+
 private:
 	void initPlatformPlugin();
 	void initSession();
 	void initConfiguration();
 	void initLogging( const QString& appComponentName );
+	static QString loggerAppName( const QString& appComponentName );
 	void initLocaleAndTranslation();
 	void initUi();
 	void initCryptoCore();
@@ -50,4 +50,7 @@ public:
 
 	virtual void setMinimumFramebufferUpdateInterval(const MessageContext& context, int interval) = 0;
 
+	// allows sending replies in formats only supported by newer clients (e.g. compressed arguments)
+	virtual void setClientApplicationVersion(const MessageContext& context, VeyonCore::ApplicationVersion version) = 0;
+
 };
@@ -301,6 +301,33 @@ void VncConnection::setFramebufferUpdateInterval( int interval )
 
 
 
+void VncConnection::setSkipFramebufferUpdates(bool on)
+{
+	const auto wasSkipping = isControlFlagSet(ControlFlag::SkipFramebufferUpdates);
+
+	setControlFlag(ControlFlag::SkipFramebufferUpdates, on);
+
+	// catch up with all changes made in the meantime as soon as possible
+	if (wasSkipping && on == false && state() == State::Connected)
+	{
+		setControlFlag(ControlFlag::TriggerFramebufferUpdate, true);
+		m_updateIntervalSleeper.wakeAll();
+	}
+}
+
+
+
+void VncConnection::requestFullFramebufferUpdate()
+{
+	if (state() == State::Connected)
+	{
+		setControlFlag(ControlFlag::TriggerFullFramebufferUpdate, true);
+		m_updateIntervalSleeper.wakeAll();
+	}
+}
+
+
+
 void VncConnection::rescaleFramebuffer()
 {
 	if( hasValidFramebuffer() == false || m_scaledSize.isNull() )
@@ -594,6 +621,13 @@ void VncConnection::handleConnection()
 			requestFrameufferUpdate(FramebufferUpdateType::Incremental);
 			m_incrementalFramebufferUpdateTimer.restart();
 		}
+		else if (isControlFlagSet(ControlFlag::TriggerFullFramebufferUpdate))
+		{
+			setControlFlag(ControlFlag::TriggerFullFramebufferUpdate, false);
+			setControlFlag(ControlFlag::TriggerFramebufferUpdate, false);
+			requestFrameufferUpdate(FramebufferUpdateType::Full);
+			m_fullFramebufferUpdateTimer.restart();
+		}
 		else if (isControlFlagSet(ControlFlag::TriggerFramebufferUpdate))
 		{
 			setControlFlag(ControlFlag::TriggerFramebufferUpdate, false);
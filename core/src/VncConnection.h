@@ -128,10 +128,9 @@ public:
 
 	void setFramebufferUpdateInterval( int interval );
 
-	void setSkipFramebufferUpdates(bool on)
-	{
-		setControlFlag(ControlFlag::SkipFramebufferUpdates, on);
-	}
+	void setSkipFramebufferUpdates(bool on);
+
+	void requestFullFramebufferUpdate();
 
 	void setSkipHostPing( bool on )
 	{
@@ -186,7 +185,8 @@ private:
 		SkipHostPing = 0x20,
 		RequiresManualUpdateRateControl = 0x40,
 		TriggerFramebufferUpdate = 0x80,
-		SkipFramebufferUpdates = 0x100
+		SkipFramebufferUpdates = 0x100,
+		TriggerFullFramebufferUpdate = 0x200
 	};
 
 	~VncConnection() override;
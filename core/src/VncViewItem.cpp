@@ -35,6 +35,10 @@ VncViewItem::VncViewItem( const ComputerControlInterface::Pointer& computerContr
 {
 	connectUpdateFunctions( this );
 
+	connect( connection(), &VncConnection::imageUpdated, this, [this]( int x, int y, int w, int h ) {
+		m_dirtyRegion += QRect( x, y, w, h ).translated( -viewport().topLeft() );
+	} );
+
 	setAcceptHoverEvents( true );
 	setAcceptedMouseButtons( Qt::AllButtons );
 	setKeepMouseGrab( true );
@@ -57,32 +61,25 @@ QSGNode* VncViewItem::updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* up
 {
 	Q_UNUSED(updatePaintNodeData)
 
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-	// TODO
-	return oldNode;
-#else
 	auto* node = static_cast<QSGSimpleTextureNode *>(oldNode);
 	if( !node )
 	{
 		node = new QSGSimpleTextureNode();
 		auto texture = new QSGImageTexture();
 		node->setTexture( texture );
+		node->setOwnsTexture( true );
 	}
 
 	const auto texture = qobject_cast<QSGImageTexture *>( node->texture() );
 
-	if( viewport().isValid() )
-	{
-		texture->setImage( computerControlInterface()->framebuffer().copy( viewport() ) );
-	}
-	else
-	{
-		texture->setImage( computerControlInterface()->framebuffer() );
-	}
+	// the texture only uploads the dirty parts of the viewport if its contents are still valid
+	texture->updateImage( computerControlInterface()->framebuffer(), viewport(), m_dirtyRegion );
+	m_dirtyRegion = {};
+
 	node->setRect( boundingRect() );
+	node->markDirty( QSGNode::DirtyMaterial );
 
 	return node;
-#endif
 }
 
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QQuickItem>
+#include <QRegion>
 
 #include "VncView.h"
 
@@ -48,4 +49,7 @@ protected:
 private:
 	QSize m_framebufferSize;
 
+	// updated framebuffer areas (relative to viewport) not yet uploaded to the texture
+	QRegion m_dirtyRegion;
+
 };
@@ -42,6 +42,13 @@ VncViewWidget::VncViewWidget( const ComputerControlInterface::Pointer& computerC
 
 	connectUpdateFunctions( this );
 
+	connect( connection(), &VncConnection::imageUpdated, this, [this]( int x, int y, int w, int h ) {
+		if( m_scaledImage.isNull() == false )
+		{
+			m_scaledImageDirtyRegion += QRect( x, y, w, h ).translated( -viewport().topLeft() );
+		}
+	} );
+
 	connect( connection(), &VncConnection::stateChanged, this, &VncViewWidget::updateConnectionState );
 	connect( &m_busyIndicatorTimer, &QTimer::timeout, this, QOverload<>::of(&QWidget::repaint) );
 
@@ -137,7 +144,16 @@ void VncViewWidget::setViewOnly( bool enabled )
 
 void VncViewWidget::updateView( int x, int y, int w, int h )
 {
-	update( x, y, w, h );
+	if( isScaledView() )
+	{
+		// rescaled areas extend beyond the updated rectangle by the filter margin
+		const auto margin = ScaledImageFilterMargin + 1;
+		update( QRect( x, y, w, h ).adjusted( -margin, -margin, margin, margin ) );
+	}
+	else
+	{
+		update( x, y, w, h );
+	}
 }
 
 
@@ -267,11 +283,16 @@ void VncViewWidget::paintEvent( QPaintEvent* paintEvent )
 
 	if( isScaledView() )
 	{
-		// repaint everything in scaled mode to avoid artifacts at rectangle boundaries
-		p.drawImage( QRect( QPoint( 0, 0 ), scaledSize() ), image, source );
+		updateScaledImage( image, source );
+
+		const auto exposedRect = paintEvent->rect().intersected( m_scaledImage.rect() );
+		p.drawImage( exposedRect, m_scaledImage, exposedRect );
 	}
 	else
 	{
+		m_scaledImage = {};
+		m_scaledImageDirtyRegion = {};
+
 		p.drawImage( { 0, 0 }, image, source );
 	}
 
@@ -307,6 +328,60 @@ void VncViewWidget::resizeEvent( QResizeEvent* event )
 
 
 
+void VncViewWidget::updateScaledImage( const QImage& image, QRect source )
+{
+	const auto size = scaledSize();
+
+	if( m_scaledImage.size() != size || m_scaledImage.format() != image.format() || m_scaledImageSource != source )
+	{
+		m_scaledImage = QImage( size, image.format() );
+		m_scaledImageSource = source;
+		m_scaledImageDirtyRegion = {};
+
+		QPainter painter( &m_scaledImage );
+		painter.setRenderHint( QPainter::SmoothPixmapTransform );
+		painter.drawImage( m_scaledImage.rect(), image, source );
+		return;
+	}
+
+	if( m_scaledImageDirtyRegion.isEmpty() )
+	{
+		return;
+	}
+
+	const auto scaleX = qreal( size.width() ) / source.width();
+	const auto scaleY = qreal( size.height() ) / source.height();
+	const QRect sourceBounds{ QPoint( 0, 0 ), source.size() };
+
+	QPainter painter( &m_scaledImage );
+	painter.setRenderHint( QPainter::SmoothPixmapTransform );
+
+	const auto scaledRect = [=]( const QRect& rect ) {
+		return QRectF( rect.x() * scaleX, rect.y() * scaleY,
+					   rect.width() * scaleX, rect.height() * scaleY ).toAlignedRect().intersected( m_scaledImage.rect() );
+	};
+
+	for( const auto& dirtyRect : std::as_const(m_scaledImageDirtyRegion) )
+	{
+		// sample from a rectangle extended by the filter margin but only overwrite the dirty area itself
+		// since pixels close to the edges of the drawn rectangle are sampled with clamping
+		const auto clipRect = scaledRect( dirtyRect.intersected( sourceBounds ) );
+		const auto targetRect = scaledRect( dirtyRect.adjusted( -ScaledImageFilterMargin, -ScaledImageFilterMargin,
+																ScaledImageFilterMargin, ScaledImageFilterMargin ).intersected( sourceBounds ) );
+
+		// map the pixel-aligned target rectangle back so it is sampled exactly like in a full rescale
+		const QRectF sourceRect{ source.x() + targetRect.x() / scaleX, source.y() + targetRect.y() / scaleY,
+								 targetRect.width() / scaleX, targetRect.height() / scaleY };
+
+		painter.setClipRect( clipRect );
+		painter.drawImage( QRectF( targetRect ), image, sourceRect );
+	}
+
+	m_scaledImageDirtyRegion = {};
+}
+
+
+
 void VncViewWidget::drawBusyIndicator( QPainter* painter )
 {
 	static constexpr int BusyIndicatorSize = 100;
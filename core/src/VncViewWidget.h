@@ -65,6 +65,14 @@ protected:
 private:
 	void drawBusyIndicator( QPainter* painter );
 	void updateConnectionState();
+	void updateScaledImage( const QImage& image, QRect source );
+
+	// number of framebuffer pixels around updated areas taken into account when smoothly rescaling them
+	static constexpr auto ScaledImageFilterMargin = 2;
+
+	QImage m_scaledImage{};
+	QRect m_scaledImageSource{};
+	QRegion m_scaledImageDirtyRegion{};
 
 	bool m_viewOnlyFocus{true};
 
@@ -33,10 +33,34 @@ Rectangle {
 		//clip: true
 		id: computerItemLayout
 		spacing: 0
-		Image {
-			source: imageId;
+		Item {
+			// request thumbnails in the size actually displayed so they get scaled by the image provider
+			property size thumbnailSize: Qt.size( view.cellWidth - 10, view.cellHeight - 28 - label.implicitHeight )
 			Layout.alignment: Qt.AlignCenter
 			Layout.margins: 5
+			Layout.preferredWidth: thumbnailSize.width
+			Layout.preferredHeight: thumbnailSize.height
+			// keep showing the previous frame while the next one is being loaded asynchronously
+			Image {
+				id: previousImage
+				anchors.fill: parent
+				fillMode: Image.PreserveAspectFit
+				sourceSize: parent.thumbnailSize
+				visible: currentImage.status !== Image.Ready
+			}
+			Image {
+				id: currentImage
+				anchors.fill: parent
+				fillMode: Image.PreserveAspectFit
+				sourceSize: parent.thumbnailSize
+				source: imageId;
+				onStatusChanged: {
+					if( status === Image.Ready )
+					{
+						previousImage.source = source
+					}
+				}
+			}
 			MouseArea {
 				anchors.fill: parent
 				onClicked: item.selected = !item.selected
@@ -66,6 +66,24 @@ Page {
 				textColor: computerMonitoring.textColor
 			}
 
+			onContentYChanged: reportVisibleRange()
+			onHeightChanged: reportVisibleRange()
+			onWidthChanged: reportVisibleRange()
+			onCountChanged: reportVisibleRange()
+			onCellHeightChanged: reportVisibleRange()
+
+			function reportVisibleRange()
+			{
+				let first = indexAt( contentX + 1, contentY + 1 )
+				let last = indexAt( contentX + width - 1, contentY + height - 1 )
+				if( last < 0 )
+				{
+					// last row is not completely filled or not reached
+					last = count - 1
+				}
+				computerMonitoring.setVisibleRange( first, last )
+			}
+
 			ScrollBar.vertical: ScrollBar {
 				visible: computerMonitoringView.contentHeight > computerMonitoringView.height
 				policy: visible ? ScrollBar.AlwaysOn : ScrollBar.AlwaysOff
@@ -22,13 +22,16 @@
  *
  */
 
+#include <QGuiApplication>
 #include <QPainter>
+#include <QScreen>
 
 #include "ComputerControlListModel.h"
 #include "ComputerImageProvider.h"
 #include "ComputerManager.h"
 #include "FeatureManager.h"
 #include "PlatformSessionFunctions.h"
+#include "VeyonConfiguration.h"
 #include "VeyonMaster.h"
 #include "UserConfig.h"
 
@@ -51,6 +54,14 @@ ComputerControlListModel::ComputerControlListModel( VeyonMaster* masterCore, QOb
 	new QAbstractItemModelTester( this, QAbstractItemModelTester::FailureReportingMode::Warning, this );
 #endif
 
+	m_interfaceStartTimer.setSingleShot( true );
+	m_interfaceStartTimer.setInterval( 0 );
+	connect( &m_interfaceStartTimer, &QTimer::timeout, this, &ComputerControlListModel::startPendingComputerControlInterfaces );
+
+	m_screenUpdateTimer.setSingleShot( true );
+	m_screenUpdateTimer.setInterval( screenUpdateInterval() );
+	connect( &m_screenUpdateTimer, &QTimer::timeout, this, &ComputerControlListModel::flushScreenUpdates );
+
 	connect( &m_master->computerManager(), &ComputerManager::computerSelectionReset,
 			 this, &ComputerControlListModel::reload );
 	connect( &m_master->computerManager(), &ComputerManager::computerSelectionChanged,
@@ -101,7 +112,7 @@ QVariant ComputerControlListModel::data( const QModelIndex& index, int role ) co
 		return computerDisplayRole( computerControl );
 
 	case Qt::InitialSortOrderRole:
-		return computerSortRole( computerControl );
+		return cachedSortKey( computerControl );
 
 	case UidRole:
 		return uidRoleData(computerControl);
@@ -191,9 +202,12 @@ void ComputerControlListModel::updateComputerScreenSize()
 	{
 		m_computerScreenSize = newSize;
 
-		for( int i = 0; i < rowCount(); ++i )
+		m_scaledIconCache.clear();
+
+		if( rowCount() > 0 )
 		{
-			updateScreen( index( i ) );
+			m_pendingScreenUpdates.clear();
+			Q_EMIT dataChanged( index( 0 ), index( rowCount() - 1 ), { Qt::DecorationRole, ImageIdRole, FramebufferRole } );
 		}
 
 		Q_EMIT computerScreenSizeChanged();
@@ -217,14 +231,43 @@ ComputerControlInterface::Pointer ComputerControlListModel::computerControlInter
 
 ComputerControlInterface::Pointer ComputerControlListModel::computerControlInterface( NetworkObject::Uid uid ) const
 {
-	for( auto& controlInterface : m_computerControlInterfaces )
+	updateRowIndexes();
+
+	const auto row = m_uidRows.value( uid, -1 );
+	if( row >= 0 )
+	{
+		return m_computerControlInterfaces[row];
+	}
+
+	return {};
+}
+
+
+
+void ComputerControlListModel::setVisibleComputerControlInterfaces( QObject* view,
+																	const ComputerControlInterfaceList& controlInterfaces )
+{
+	if( m_visibleInterfaces.contains( view ) == false )
 	{
-		if( controlInterface->computer().networkObjectUid() == uid )
+		if( controlInterfaces.isEmpty() )
 		{
-			return controlInterface;
+			return;
 		}
+
+		connect( view, &QObject::destroyed, this, [this, view]() {
+			m_visibleInterfaces.remove( view );
+			updateFramebufferSubscriptions();
+		} );
 	}
-	return {};
+
+	auto& visibleInterfaces = m_visibleInterfaces[view];
+	visibleInterfaces.clear();
+	for( const auto& controlInterface : controlInterfaces )
+	{
+		visibleInterfaces.insert( controlInterface.data() );
+	}
+
+	updateFramebufferSubscriptions();
 }
 
 
@@ -241,26 +284,26 @@ QImage ComputerControlListModel::computerDecorationRole( const ComputerControlIn
 			return image;
 		}
 
-		return scaleAndAlignIcon(m_iconHostOnline, controlInterface->scaledFramebufferSize());
+		return cachedScaledIcon(m_iconHostOnline, controlInterface->scaledFramebufferSize());
 	}
 
 	case ComputerControlInterface::State::HostNameResolutionFailed:
-		return scaleAndAlignIcon(m_iconHostNameResolutionFailed, controlInterface->scaledFramebufferSize());
+		return cachedScaledIcon(m_iconHostNameResolutionFailed, controlInterface->scaledFramebufferSize());
 
 	case ComputerControlInterface::State::ServerNotRunning:
-		return scaleAndAlignIcon(m_iconHostServiceError, controlInterface->scaledFramebufferSize());
+		return cachedScaledIcon(m_iconHostServiceError, controlInterface->scaledFramebufferSize());
 
 	case ComputerControlInterface::State::AuthenticationFailed:
-		return scaleAndAlignIcon(m_iconHostAccessDenied, controlInterface->scaledFramebufferSize());
+		return cachedScaledIcon(m_iconHostAccessDenied, controlInterface->scaledFramebufferSize());
 
 	case ComputerControlInterface::State::AccessControlFailed:
-		return scaleAndAlignIcon(m_iconHostAccessDenied, controlInterface->scaledFramebufferSize());
+		return cachedScaledIcon(m_iconHostAccessDenied, controlInterface->scaledFramebufferSize());
 
 	default:
 		break;
 	}
 
-	return scaleAndAlignIcon(m_iconHostOffline, controlInterface->scaledFramebufferSize());
+	return cachedScaledIcon(m_iconHostOffline, controlInterface->scaledFramebufferSize());
 }
 
 
@@ -272,15 +315,21 @@ void ComputerControlListModel::reload()
 	const auto computerList = m_master->computerManager().selectedComputers( QModelIndex() );
 
 	m_computerControlInterfaces.clear();
+	m_pendingInterfaceStarts.clear();
+	m_pendingInterfaceStartSet.clear();
+	m_pendingScreenUpdates.clear();
+	m_sortKeys.clear();
 	m_computerControlInterfaces.reserve( computerList.size() );
 
 	for( const auto& computer : computerList )
 	{
 		const auto controlInterface = ComputerControlInterface::Pointer::create( computer );
 		m_computerControlInterfaces.append( controlInterface );
-		startComputerControlInterface( controlInterface.data() );
+		startComputerControlInterface( controlInterface );
 	}
 
+	invalidateRowIndexes();
+
 	endResetModel();
 }
 
@@ -290,47 +339,84 @@ void ComputerControlListModel::update()
 {
 	const auto newComputerList = m_master->computerManager().selectedComputers( QModelIndex() );
 
-	int row = 0;
+	QSet<NetworkObject::Uid> newComputerUids;
+	newComputerUids.reserve( newComputerList.size() );
+	for( const auto& computer : newComputerList )
+	{
+		newComputerUids.insert( computer.networkObjectUid() );
+	}
 
-	for( auto it = m_computerControlInterfaces.begin(); it != m_computerControlInterfaces.end(); ) // clazy:exclude=detaching-member
+	const auto isSelected = [&]( int row ) {
+		return newComputerUids.contains( m_computerControlInterfaces[row]->computer().networkObjectUid() );
+	};
+
+	// remove contiguous ranges of deselected computers, starting at the end so rows before stay valid
+	for( int row = m_computerControlInterfaces.count() - 1; row >= 0; )
 	{
-		if( newComputerList.contains( (*it)->computer() ) == false )
+		if( isSelected( row ) )
 		{
-			stopComputerControlInterface( *it );
+			--row;
+			continue;
+		}
 
-			beginRemoveRows( QModelIndex(), row, row );
-			it = m_computerControlInterfaces.erase( it );
-			endRemoveRows();
+		auto first = row;
+		while( first > 0 && isSelected( first - 1 ) == false )
+		{
+			--first;
 		}
-		else
+
+		for( int i = first; i <= row; ++i )
 		{
-			++it;
-			++row;
+			stopComputerControlInterface( m_computerControlInterfaces[i] );
 		}
+
+		beginRemoveRows( QModelIndex(), first, row );
+		m_computerControlInterfaces.erase( m_computerControlInterfaces.begin() + first,
+										   m_computerControlInterfaces.begin() + row + 1 );
+		invalidateRowIndexes();
+		endRemoveRows();
+
+		row = first - 1;
 	}
 
-	row = 0;
+	// insert contiguous ranges of newly selected computers
+	int row = 0;
 
-	for( const auto& computer : newComputerList )
+	for( int i = 0; i < newComputerList.count(); )
 	{
-		if( row < m_computerControlInterfaces.count() && m_computerControlInterfaces[row]->computer() != computer )
+		const auto matchesRow = [&]( int index ) {
+			return row < m_computerControlInterfaces.count() &&
+					m_computerControlInterfaces[row]->computer() == newComputerList[index];
+		};
+
+		if( matchesRow( i ) )
+		{
+			++row;
+			++i;
+			continue;
+		}
+
+		auto last = i;
+		while( last + 1 < newComputerList.count() && matchesRow( last + 1 ) == false )
 		{
-			beginInsertRows( QModelIndex(), row, row );
-			const auto controlInterface = ComputerControlInterface::Pointer::create( computer );
-			m_computerControlInterfaces.insert( row, controlInterface );
-			startComputerControlInterface( controlInterface.data() );
-			endInsertRows();
+			++last;
 		}
-		else if( row >= m_computerControlInterfaces.count() )
+
+		const auto count = last - i + 1;
+
+		beginInsertRows( QModelIndex(), row, row + count - 1 );
+		m_computerControlInterfaces.insert( row, count, ComputerControlInterface::Pointer{} );
+		for( int j = 0; j < count; ++j )
 		{
-			beginInsertRows( QModelIndex(), row, row );
-			const auto controlInterface = ComputerControlInterface::Pointer::create( computer );
-			m_computerControlInterfaces.append( controlInterface );
-			startComputerControlInterface( controlInterface.data() );
-			endInsertRows();
+			const auto controlInterface = ComputerControlInterface::Pointer::create( newComputerList[i + j] );
+			m_computerControlInterfaces[row + j] = controlInterface;
+			startComputerControlInterface( controlInterface );
 		}
+		invalidateRowIndexes();
+		endInsertRows();
 
-		++row;
+		row += count;
+		i = last + 1;
 	}
 
 	updateComputerScreenSize();
@@ -338,9 +424,47 @@ void ComputerControlListModel::update()
 
 
 
+void ComputerControlListModel::invalidateRowIndexes()
+{
+	m_rowIndexesValid = false;
+}
+
+
+
+void ComputerControlListModel::updateRowIndexes() const
+{
+	if( m_rowIndexesValid )
+	{
+		return;
+	}
+
+	m_uidRows.clear();
+	m_interfaceRows.clear();
+
+	m_uidRows.reserve( m_computerControlInterfaces.size() );
+	m_interfaceRows.reserve( m_computerControlInterfaces.size() );
+
+	for( int row = 0; row < m_computerControlInterfaces.size(); ++row )
+	{
+		const auto& controlInterface = m_computerControlInterfaces[row];
+		// keep first match for duplicate UIDs
+		if( m_uidRows.contains( controlInterface->computer().networkObjectUid() ) == false )
+		{
+			m_uidRows.insert( controlInterface->computer().networkObjectUid(), row );
+		}
+		m_interfaceRows.insert( controlInterface.data(), row );
+	}
+
+	m_rowIndexesValid = true;
+}
+
+
+
 QModelIndex ComputerControlListModel::interfaceIndex( ComputerControlInterface* controlInterface ) const
 {
-	return ComputerListModel::index( m_computerControlInterfaces.indexOf( controlInterface->weakPointer() ), 0 );
+	updateRowIndexes();
+
+	return ComputerListModel::index( m_interfaceRows.value( controlInterface, -1 ), 0 );
 }
 
 
@@ -369,7 +493,7 @@ QVariant ComputerControlListModel::uidRoleData(const ComputerControlInterface::P
 void ComputerControlListModel::updateState( const QModelIndex& index )
 {
 	Q_EMIT stateChanged(index);
-	Q_EMIT dataChanged( index, index, { Qt::DisplayRole, Qt::DecorationRole, Qt::ToolTipRole, ImageIdRole, FramebufferRole } );
+	Q_EMIT dataChanged( index, index, { Qt::DisplayRole, Qt::DecorationRole, Qt::ToolTipRole, StateRole, ImageIdRole, FramebufferRole } );
 }
 
 
@@ -381,9 +505,90 @@ void ComputerControlListModel::updateAccessControlDetails(const QModelIndex& ind
 
 
 
-void ComputerControlListModel::updateScreen( const QModelIndex& index )
+void ComputerControlListModel::updateFramebufferSubscriptions()
+{
+	// views which are hidden or do not display anything (e.g. an empty spotlight) do not count
+	const auto hasVisibilityReports = std::any_of( m_visibleInterfaces.constBegin(), m_visibleInterfaces.constEnd(),
+												   []( const QSet<const ComputerControlInterface *>& visibleInterfaces ) {
+													   return visibleInterfaces.isEmpty() == false;
+												   } );
+
+	for( const auto& controlInterface : std::as_const(m_computerControlInterfaces) )
+	{
+		const auto visible = hasVisibilityReports == false ||
+				std::any_of( m_visibleInterfaces.constBegin(), m_visibleInterfaces.constEnd(),
+							 [&controlInterface]( const QSet<const ComputerControlInterface *>& visibleInterfaces ) {
+								 return visibleInterfaces.contains( controlInterface.data() );
+							 } );
+
+		controlInterface->setFramebufferUpdatesSuspended( visible == false );
+	}
+}
+
+
+
+void ComputerControlListModel::scheduleScreenUpdate( ComputerControlInterface* controlInterface )
+{
+	m_pendingScreenUpdates.insert( controlInterface );
+
+	if( m_screenUpdateTimer.isActive() == false )
+	{
+		m_screenUpdateTimer.start();
+	}
+}
+
+
+
+void ComputerControlListModel::flushScreenUpdates()
 {
-	Q_EMIT dataChanged( index, index, { Qt::DecorationRole, ImageIdRole, FramebufferRole } );
+	QVector<int> rows;
+	rows.reserve( m_pendingScreenUpdates.size() );
+
+	for( const auto* controlInterface : std::as_const(m_pendingScreenUpdates) )
+	{
+		const auto index = interfaceIndex( const_cast<ComputerControlInterface *>( controlInterface ) );
+		if( index.isValid() )
+		{
+			rows.append( index.row() );
+		}
+	}
+
+	m_pendingScreenUpdates.clear();
+
+	std::sort( rows.begin(), rows.end() );
+
+	// announce contiguous rows through a single signal each
+	for( int i = 0; i < rows.size(); )
+	{
+		int last = i;
+		while( last + 1 < rows.size() && rows[last+1] == rows[last] + 1 )
+		{
+			++last;
+		}
+
+		Q_EMIT dataChanged( index( rows[i] ), index( rows[last] ), { Qt::DecorationRole, ImageIdRole, FramebufferRole } );
+
+		i = last + 1;
+	}
+}
+
+
+
+int ComputerControlListModel::screenUpdateInterval()
+{
+	const auto configuredInterval = VeyonCore::config().computerMonitoringRepaintInterval();
+	if( configuredInterval > 0 )
+	{
+		return configuredInterval;
+	}
+
+	const auto screen = QGuiApplication::primaryScreen();
+	if( screen && screen->refreshRate() > 0 )
+	{
+		return qMax( 1, qRound( 1000 / screen->refreshRate() ) );
+	}
+
+	return DefaultScreenUpdateInterval;
 }
 
 
@@ -398,9 +603,14 @@ void ComputerControlListModel::updateActiveFeatures( const QModelIndex& index )
 
 void ComputerControlListModel::updateUser( const QModelIndex& index )
 {
-	Q_EMIT dataChanged( index, index, { Qt::DisplayRole, Qt::ToolTipRole } );
-
 	auto controlInterface = computerControlInterface( index );
+	if( controlInterface.isNull() == false )
+	{
+		m_sortKeys.remove( controlInterface.data() );
+	}
+
+	Q_EMIT dataChanged( index, index, { Qt::DisplayRole, Qt::ToolTipRole, Qt::InitialSortOrderRole, UserLoginNameRole } );
+
 	if( controlInterface.isNull() == false )
 	{
 		m_master->computerManager().updateUser( controlInterface );
@@ -411,17 +621,23 @@ void ComputerControlListModel::updateUser( const QModelIndex& index )
 
 void ComputerControlListModel::updateSessionInfo(const QModelIndex& index)
 {
+	// computer name may be derived from session information
+	auto controlInterface = computerControlInterface( index );
+	if (controlInterface.isNull() == false)
+	{
+		m_sortKeys.remove(controlInterface.data());
+	}
+
 	if (uidRoleContent() == UidRoleContent::SessionMetaDataHash)
 	{
-		Q_EMIT dataChanged(index, index, {Qt::ToolTipRole, UidRole});
+		Q_EMIT dataChanged(index, index, {Qt::DisplayRole, Qt::ToolTipRole, Qt::InitialSortOrderRole, UidRole});
 	}
 	else
 	{
-		Q_EMIT dataChanged(index, index, {Qt::ToolTipRole});
+		Q_EMIT dataChanged(index, index, {Qt::DisplayRole, Qt::ToolTipRole, Qt::InitialSortOrderRole});
 
 	}
 
-	auto controlInterface = computerControlInterface( index );
 	if (controlInterface.isNull() == false)
 	{
 		m_master->computerManager().updateSessionInfo(controlInterface);
@@ -430,15 +646,23 @@ void ComputerControlListModel::updateSessionInfo(const QModelIndex& index)
 
 
 
-void ComputerControlListModel::startComputerControlInterface( ComputerControlInterface* controlInterface )
+void ComputerControlListModel::startComputerControlInterface( const ComputerControlInterface::Pointer& sharedControlInterface )
 {
-	controlInterface->start( computerScreenSize(), ComputerControlInterface::UpdateMode::Monitoring );
+	// connecting to many computers at once would block the GUI so defer it to startPendingComputerControlInterfaces()
+	m_pendingInterfaceStarts.append( sharedControlInterface );
+	m_pendingInterfaceStartSet.insert( sharedControlInterface.data() );
+	if( m_interfaceStartTimer.isActive() == false )
+	{
+		m_interfaceStartTimer.start();
+	}
+
+	auto controlInterface = sharedControlInterface.data();
 
 	connect( controlInterface, &ComputerControlInterface::framebufferSizeChanged,
 			 this, &ComputerControlListModel::updateComputerScreenSize );
 
 	connect( controlInterface, &ComputerControlInterface::scaledFramebufferUpdated,
-			 this, [=] () { updateScreen( interfaceIndex( controlInterface ) ); } );
+			 this, [=] () { scheduleScreenUpdate( controlInterface ); } );
 
 	connect( controlInterface, &ComputerControlInterface::activeFeaturesChanged,
 			 this, [=] () { updateActiveFeatures( interfaceIndex( controlInterface ) ); } );
@@ -458,6 +682,33 @@ void ComputerControlListModel::startComputerControlInterface( ComputerControlInt
 
 
 
+void ComputerControlListModel::startPendingComputerControlInterfaces()
+{
+	int processed = 0;
+	int started = 0;
+
+	while( processed < m_pendingInterfaceStarts.count() && started < InterfaceStartBatchSize )
+	{
+		const auto& controlInterface = m_pendingInterfaceStarts.at( processed++ );
+
+		// skip interfaces which have been stopped in the meantime
+		if( m_pendingInterfaceStartSet.remove( controlInterface.data() ) )
+		{
+			controlInterface->start( computerScreenSize(), ComputerControlInterface::UpdateMode::Monitoring );
+			++started;
+		}
+	}
+
+	m_pendingInterfaceStarts.erase( m_pendingInterfaceStarts.begin(), m_pendingInterfaceStarts.begin() + processed );
+
+	if( m_pendingInterfaceStarts.isEmpty() == false )
+	{
+		m_interfaceStartTimer.start();
+	}
+}
+
+
+
 void ComputerControlListModel::stopComputerControlInterface( const ComputerControlInterface::Pointer& controlInterface )
 {
 	m_master->stopAllFeatures( { controlInterface } );
@@ -465,6 +716,10 @@ void ComputerControlListModel::stopComputerControlInterface( const ComputerContr
 	controlInterface->disconnect(this);
 	controlInterface->disconnect( &m_master->computerManager() );
 
+	m_pendingInterfaceStartSet.remove( controlInterface.data() );
+	m_pendingScreenUpdates.remove( controlInterface.data() );
+	m_sortKeys.remove( controlInterface.data() );
+
 	m_master->computerManager().clearOverlayModelData(controlInterface);
 }
 
@@ -488,6 +743,30 @@ double ComputerControlListModel::averageAspectRatio() const
 
 
 
+QImage ComputerControlListModel::cachedScaledIcon( const QImage& icon, QSize size ) const
+{
+	if( size != m_scaledIconCacheSize )
+	{
+		m_scaledIconCache.clear();
+		m_scaledIconCacheSize = size;
+	}
+
+	const auto cacheKey = icon.cacheKey();
+
+	const auto it = m_scaledIconCache.constFind( cacheKey );
+	if( it != m_scaledIconCache.constEnd() )
+	{
+		return *it;
+	}
+
+	const auto scaledIcon = scaleAndAlignIcon( icon, size );
+	m_scaledIconCache.insert( cacheKey, scaledIcon );
+
+	return scaledIcon;
+}
+
+
+
 QImage ComputerControlListModel::scaleAndAlignIcon( const QImage& icon, QSize size ) const
 {
 	const auto scaledIcon = icon.scaled(size.width(), size.height(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
@@ -596,6 +875,19 @@ QString ComputerControlListModel::computerSortRole( const ComputerControlInterfa
 
 
 
+QString ComputerControlListModel::cachedSortKey( const ComputerControlInterface::Pointer& controlInterface ) const
+{
+	auto it = m_sortKeys.constFind( controlInterface.data() );
+	if( it == m_sortKeys.constEnd() )
+	{
+		it = m_sortKeys.insert( controlInterface.data(), computerSortRole( controlInterface ) );
+	}
+
+	return *it;
+}
+
+
+
 QString ComputerControlListModel::computerStateDescription( const ComputerControlInterface::Pointer& controlInterface )
 {
 	switch( controlInterface->state() )
@@ -27,6 +27,7 @@
 #include <QAbstractListModel>
 #include <QQuickImageProvider>
 #include <QImage>
+#include <QTimer>
 
 #include "ComputerListModel.h"
 #include "ComputerControlInterface.h"
@@ -70,33 +71,48 @@ public:
 
 	void reload();
 
+	// views report which interfaces they currently display - all others do not receive framebuffer updates
+	void setVisibleComputerControlInterfaces( QObject* view, const ComputerControlInterfaceList& controlInterfaces );
+
 Q_SIGNALS:
 	void stateChanged(QModelIndex);
 	void activeFeaturesChanged( QModelIndex );
 	void computerScreenSizeChanged();
 
 private:
+	static constexpr auto DefaultScreenUpdateInterval = 16;
+	static constexpr auto InterfaceStartBatchSize = 25;
+
 	void update();
 
+	void invalidateRowIndexes();
+	void updateRowIndexes() const;
+
 	QModelIndex interfaceIndex( ComputerControlInterface* controlInterface ) const;
 	QVariant uidRoleData(const ComputerControlInterface::Pointer& controlInterface) const;
 
 	void updateState( const QModelIndex& index );
 	void updateAccessControlDetails(const QModelIndex& index);
-	void updateScreen( const QModelIndex& index );
+	void updateFramebufferSubscriptions();
+	void scheduleScreenUpdate( ComputerControlInterface* controlInterface );
+	void flushScreenUpdates();
+	static int screenUpdateInterval();
 	void updateActiveFeatures( const QModelIndex& index );
 	void updateUser( const QModelIndex& index );
 	void updateSessionInfo(const QModelIndex& index);
 
-	void startComputerControlInterface( ComputerControlInterface* controlInterface );
+	void startComputerControlInterface( const ComputerControlInterface::Pointer& sharedControlInterface );
+	void startPendingComputerControlInterfaces();
 	void stopComputerControlInterface( const ComputerControlInterface::Pointer& controlInterface );
 
 	double averageAspectRatio() const;
 
+	QImage cachedScaledIcon( const QImage& icon, QSize size ) const;
 	QImage scaleAndAlignIcon( const QImage& icon, QSize size ) const;
 	QString computerToolTipRole( const ComputerControlInterface::Pointer& controlInterface ) const;
 	QString computerDisplayRole( const ComputerControlInterface::Pointer& controlInterface ) const;
 	QString computerSortRole( const ComputerControlInterface::Pointer& controlInterface ) const;
+	QString cachedSortKey( const ComputerControlInterface::Pointer& controlInterface ) const;
 	static QString computerStateDescription( const ComputerControlInterface::Pointer& controlInterface );
 	static QString userInformation(const ComputerControlInterface::Pointer& controlInterface);
 	static QString activeFeaturesInformation(const ComputerControlInterface::Pointer& controlInterface);
@@ -112,6 +128,30 @@ private:
 
 	QSize m_computerScreenSize{};
 
+	// scaled and aligned versions of above icons (keyed by QImage::cacheKey()) for m_scaledIconCacheSize
+	mutable QHash<qint64, QImage> m_scaledIconCache;
+	mutable QSize m_scaledIconCacheSize{};
+
 	ComputerControlInterfaceList m_computerControlInterfaces{};
 
+	// interfaces are started in batches across several event loop iterations - entries of stopped
+	// interfaces are removed from the set only and are skipped when processing the queue
+	ComputerControlInterfaceList m_pendingInterfaceStarts{};
+	QSet<const ComputerControlInterface *> m_pendingInterfaceStartSet{};
+	QTimer m_interfaceStartTimer{this};
+
+	// framebuffer updates are collected and announced at most once per display frame
+	QSet<const ComputerControlInterface *> m_pendingScreenUpdates{};
+	QTimer m_screenUpdateTimer{this};
+
+	QHash<const QObject *, QSet<const ComputerControlInterface *>> m_visibleInterfaces{};
+
+	// results of computerSortRole(), dropped whenever user or computer name may have changed
+	mutable QHash<const ComputerControlInterface *, QString> m_sortKeys{};
+
+	// lookup tables for rows of m_computerControlInterfaces, rebuilt lazily after structural changes
+	mutable QHash<NetworkObject::Uid, int> m_uidRows{};
+	mutable QHash<const ComputerControlInterface *, int> m_interfaceRows{};
+	mutable bool m_rowIndexesValid{false};
+
 };
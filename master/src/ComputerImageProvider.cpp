@@ -22,27 +22,138 @@
  *
  */
 
+#include <QPointer>
+#include <QtConcurrent>
+
 #include "ComputerControlListModel.h"
 #include "ComputerImageProvider.h"
 
+
+QQuickTextureFactory* ComputerImageResponse::textureFactory() const
+{
+	return QQuickTextureFactory::textureFactoryForImage( m_image );
+}
+
+
+
+void ComputerImageResponse::finish( const QImage& image )
+{
+	m_image = image;
+
+	Q_EMIT finished();
+}
+
+
+
 ComputerImageProvider::ComputerImageProvider( ComputerControlListModel* model ) :
-	QQuickImageProvider( QQmlImageProviderBase::Image ),
+	QQuickAsyncImageProvider(),
 	m_model( model )
 {
+	m_threadPool.setMaxThreadCount( qMax( 1, QThread::idealThreadCount() / 2 ) );
+
+	// drop thumbnails of computers no longer in the model, e.g. after switching locations
+	QObject::connect( m_model, &QAbstractItemModel::rowsRemoved, &m_context, [this]() { pruneThumbnails(); } );
+	QObject::connect( m_model, &QAbstractItemModel::modelReset, &m_context, [this]() { pruneThumbnails(); } );
 }
 
 
 
-QImage ComputerImageProvider::requestImage( const QString& id, QSize* size, const QSize& requestedSize )
+ComputerImageProvider::~ComputerImageProvider()
 {
-	Q_UNUSED(size)
-	Q_UNUSED(requestedSize)
+	m_threadPool.waitForDone();
+}
+
+
+
+QQuickImageResponse* ComputerImageProvider::requestImageResponse( const QString& id, const QSize& requestedSize )
+{
+	// ID format: <computer UID>/<timestamp>
+	const auto separatorIndex = id.indexOf( QLatin1Char('/') );
+	const auto computerId = id.left( separatorIndex );
+	const auto timestamp = separatorIndex >= 0 ? id.mid( separatorIndex + 1 ) : QString{};
+
+	auto response = new ComputerImageResponse;
+
+	QMutexLocker locker( &m_thumbnailsMutex );
+	const auto thumbnail = m_thumbnails.constFind( computerId );
+	if( thumbnail != m_thumbnails.constEnd() &&
+		thumbnail->timestamp == timestamp &&
+		thumbnail->size == requestedSize )
+	{
+		const auto image = thumbnail->image;
+		locker.unlock();
+
+		// finish asynchronously as the caller has not connected to the response yet
+		(void) QtConcurrent::run( &m_threadPool, [response, image]() { response->finish( image ); } );
 
-	const auto controlInterface = m_model->computerControlInterface( NetworkObject::Uid{id} );
+		return response;
+	}
+	locker.unlock();
+
+	// the model may only be accessed from the main thread while this function runs in QML's loader thread
+	QPointer<ComputerImageResponse> responsePointer( response );
+	// queue on our context object so the call is dropped if the QML engine destroys us before the model
+	QMetaObject::invokeMethod( &m_context, [=]() {
+		if( responsePointer )
+		{
+			prepareThumbnail( responsePointer, computerId, timestamp, requestedSize );
+		}
+	}, Qt::QueuedConnection );
+
+	return response;
+}
+
+
+
+void ComputerImageProvider::prepareThumbnail( ComputerImageResponse* response, const QString& computerId,
+											  const QString& timestamp, const QSize& requestedSize )
+{
+	QImage image;
+
+	const auto controlInterface = m_model->computerControlInterface( NetworkObject::Uid{computerId} );
 	if( controlInterface )
 	{
-		return m_model->computerDecorationRole( controlInterface );
+		image = m_model->computerDecorationRole( controlInterface );
+	}
+
+	(void) QtConcurrent::run( &m_threadPool, [=]() {
+		auto thumbnail = image;
+		if( requestedSize.width() > 0 && requestedSize.height() > 0 &&
+			thumbnail.isNull() == false && thumbnail.size() != requestedSize )
+		{
+			thumbnail = thumbnail.scaled( requestedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation );
+		}
+
+		m_thumbnailsMutex.lock();
+		m_thumbnails[computerId] = { timestamp, requestedSize, thumbnail };
+		m_thumbnailsMutex.unlock();
+
+		response->finish( thumbnail );
+	} );
+}
+
+
+
+void ComputerImageProvider::pruneThumbnails()
+{
+	QSet<QString> computerIds;
+	computerIds.reserve( m_model->computerControlInterfaces().size() );
+
+	for( const auto& controlInterface : m_model->computerControlInterfaces() )
+	{
+		computerIds.insert( VeyonCore::formattedUuid( controlInterface->computer().networkObjectUid() ) );
 	}
 
-	return {};
+	QMutexLocker locker( &m_thumbnailsMutex );
+	for( auto it = m_thumbnails.begin(); it != m_thumbnails.end(); )
+	{
+		if( computerIds.contains( it.key() ) )
+		{
+			++it;
+		}
+		else
+		{
+			it = m_thumbnails.erase( it );
+		}
+	}
 }
@@ -24,17 +24,34 @@
 
 #pragma once
 
-#include <QQuickImageProvider>
+#include <QMutex>
+#include <QQuickAsyncImageProvider>
+#include <QThreadPool>
 
 class ComputerControlListModel;
 
+class ComputerImageResponse : public QQuickImageResponse
+{
+	Q_OBJECT
+public:
+	QQuickTextureFactory* textureFactory() const override;
+
+	void finish( const QImage& image );
+
+private:
+	QImage m_image;
+
+};
+
+
 // clazy:excludeall=copyable-polymorphic
-class ComputerImageProvider : public QQuickImageProvider
+class ComputerImageProvider : public QQuickAsyncImageProvider
 {
 public:
 	explicit ComputerImageProvider( ComputerControlListModel* model );
+	~ComputerImageProvider() override;
 
-	QImage requestImage( const QString& id, QSize *size, const QSize &requestedSize ) override;
+	QQuickImageResponse* requestImageResponse( const QString& id, const QSize& requestedSize ) override;
 
 	QString id() const
 	{
@@ -42,6 +59,26 @@ public:
 	}
 
 private:
+	struct Thumbnail
+	{
+		QString timestamp;
+		QSize size;
+		QImage image;
+	};
+
+	void prepareThumbnail( ComputerImageResponse* response, const QString& computerId,
+						   const QString& timestamp, const QSize& requestedSize );
+	void pruneThumbnails();
+
 	ComputerControlListModel* m_model;
 
+	QThreadPool m_threadPool{};
+
+	// last thumbnail prepared per computer, reused as long as timestamp and size do not change
+	QMutex m_thumbnailsMutex{};
+	QHash<QString, Thumbnail> m_thumbnails{};
+
+	// lives in the main thread and receives all calls accessing the model
+	QObject m_context{};
+
 };
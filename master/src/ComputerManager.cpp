@@ -22,14 +22,20 @@
  *
  */
 
+#include <algorithm>
+#include <memory>
+
 #include <QCoreApplication>
 #include <QFile>
+#include <QFutureWatcher>
 #include <QHostAddress>
 #include <QHostInfo>
 #include <QMessageBox>
 #include <QTime>
+#include <QtConcurrent>
 
 #include "ComputerManager.h"
+#include "HostAddress.h"
 #include "VeyonConfiguration.h"
 #include "NetworkObject.h"
 #include "NetworkObjectDirectory.h"
@@ -231,6 +237,7 @@ void ComputerManager::checkChangedData( const QModelIndex& topLeft, const QModel
 
 	if( roles.contains( Qt::CheckStateRole ) )
 	{
+		m_computerSelectionModified = true;
 		Q_EMIT computerSelectionChanged();
 	}
 }
@@ -249,10 +256,32 @@ void ComputerManager::initLocations()
 		vDebug() << "initializing locations for host address" << address.toString();
 	}
 
-	const auto currentLocation = findLocationOfComputer(m_localHostNames, m_localHostAddresses, {});
-	if (currentLocation.isEmpty() == false)
+	if( VeyonCore::config().showCurrentLocationOnly() )
 	{
-		m_currentLocations.append(currentLocation);
+		// do not show any location until the current location is known
+		m_networkObjectFilterProxyModel->setGroupFilter( { QString() } );
+	}
+
+	// resolving host names and querying the directory can take a while so don't block the UI
+	auto watcher = new QFutureWatcher<DetectedLocation>( this );
+	connect( watcher, &QFutureWatcher<DetectedLocation>::finished, this, [this, watcher]() {
+		setCurrentLocation( watcher->result() );
+		watcher->deleteLater();
+	} );
+	watcher->setFuture( QtConcurrent::run( &ComputerManager::detectLocation, m_localHostNames, m_localHostAddresses ) );
+}
+
+
+
+void ComputerManager::setCurrentLocation( const DetectedLocation& location )
+{
+	if( location.name.isEmpty() == false )
+	{
+		// prefer the name of an already loaded object, e.g. a container name instead of its DN
+		const auto loadedName = m_networkObjectDirectory->queryObjectProperty( location.uid,
+																			   NetworkObject::Property::Name ).toString();
+		m_currentLocations.append( loadedName.isEmpty() ? location.name : loadedName );
+		m_currentLocationUid = location.uid;
 	}
 
 	vDebug() << "found locations" << m_currentLocations;
@@ -273,12 +302,87 @@ void ComputerManager::initLocations()
 		m_locationFilterList = m_currentLocations;
 		updateLocationFilterList();
 	}
+
+	if( VeyonCore::config().autoSelectCurrentLocation() )
+	{
+		// containers may be populated asynchronously so select their computers once they have been fetched
+		connect( m_networkObjectDirectory, &NetworkObjectDirectory::objectsFetched,
+				 this, &ComputerManager::selectComputersAtCurrentLocations, Qt::QueuedConnection );
+
+		selectComputersAtCurrentLocations();
+	}
+}
+
+
+
+void ComputerManager::selectComputersAtCurrentLocations()
+{
+	// do not override a selection made by the user while the location was being detected or fetched
+	if( m_computerSelectionModified == false && m_currentLocationUid.isNull() == false )
+	{
+		const auto location = m_networkObjectDirectory->object( m_currentLocationUid );
+		if( location.isValid() == false )
+		{
+			// location not loaded yet - wait for the directory to fetch further objects
+			return;
+		}
+
+		// only fetch the subtree of the current location instead of all containers
+		QJsonArray computerUids;
+		if( fetchLocation( location, computerUids ) )
+		{
+			return;
+		}
+
+		m_computerTreeModel->loadStates( computerUids );
+
+		// loading the states is no modification by the user
+		m_computerSelectionModified = false;
+	}
+
+	disconnect( m_networkObjectDirectory, &NetworkObjectDirectory::objectsFetched,
+				this, &ComputerManager::selectComputersAtCurrentLocations );
+}
+
+
+
+bool ComputerManager::fetchLocation( const NetworkObject& location, QJsonArray& computerUids )
+{
+	if( location.isPopulated() == false )
+	{
+		m_networkObjectDirectory->fetchObjects( location );
+	}
+
+	// asynchronously fetched containers remain unpopulated until their objects have been received
+	auto fetching = m_networkObjectDirectory->object( location.uid() ).isPopulated() == false;
+
+	// copy as fetching objects may modify the list
+	const auto objects = m_networkObjectDirectory->objects( location );
+	for( const auto& object : objects )
+	{
+		if( object.isContainer() )
+		{
+			fetching |= fetchLocation( object, computerUids );
+		}
+		else if( object.type() == NetworkObject::Type::Host )
+		{
+			computerUids += object.uid().toString();
+		}
+	}
+
+	return fetching;
 }
 
 
 
 void ComputerManager::initNetworkObjectLayer()
 {
+	// show objects from the previous session immediately while refreshing them in the background
+	if( VeyonCore::config().networkObjectDirectorySnapshotEnabled() )
+	{
+		m_networkObjectDirectory->enableSnapshot();
+	}
+
 	m_networkObjectDirectory->update();
 	m_networkObjectDirectory->setUpdateInterval( VeyonCore::config().networkObjectDirectoryUpdateInterval() );
 	m_networkObjectOverlayDataModel->setSourceModel( m_networkObjectModel );
@@ -339,24 +443,9 @@ void ComputerManager::initNetworkObjectLayer()
 
 void ComputerManager::initComputerTreeModel()
 {
-	QJsonArray checkedNetworkObjects;
-	if( VeyonCore::config().autoSelectCurrentLocation() )
-	{
-		for( const auto& location : std::as_const( m_currentLocations ) )
-		{
-			const auto computersAtLocation = getComputersAtLocation( location );
-			for( const auto& computer : computersAtLocation )
-			{
-				checkedNetworkObjects += computer.networkObjectUid().toString();
-			}
-		}
-	}
-	else
-	{
-		checkedNetworkObjects = m_config.checkedNetworkObjects();
-	}
-
-	m_computerTreeModel->loadStates( checkedNetworkObjects );
+	// computers at the current location are selected once it has been detected
+	m_computerTreeModel->loadStates( VeyonCore::config().autoSelectCurrentLocation() ? computersAtCurrentLocations()
+																					 : m_config.checkedNetworkObjects() );
 
 	connect( computerTreeModel(), &QAbstractItemModel::modelReset,
 			 this, &ComputerManager::computerSelectionReset );
@@ -383,45 +472,119 @@ void ComputerManager::updateLocationFilterList()
 
 
 
-QString ComputerManager::findLocationOfComputer(const QStringList& hostNames, const QList<QHostAddress>& hostAddresses,
-												const QModelIndex& parent) const
+ComputerManager::DetectedLocation ComputerManager::detectLocation( const QStringList& hostNames,
+																	const QList<QHostAddress>& hostAddresses )
 {
-	QAbstractItemModel* model = networkObjectModel();
+	const auto hostKeys = normalizedHostKeys( hostNames, hostAddresses );
 
-	int rows = model->rowCount( parent );
+	// directory objects must not be shared between threads so use separate instances here - they read the
+	// configuration of their plugins concurrently to the main thread which is safe since the global configuration
+	// is only modified while initializing VeyonCore (e.g. when upgrading plugins) but never at runtime of the master
+	const auto directoryUids = VeyonCore::config().enabledNetworkObjectDirectoryPlugins();
 
-	for( int i = 0; i < rows; ++i )
+	for( const auto& directoryUid : directoryUids )
 	{
-		const auto entryIndex = model->index(i, 0, parent);
-		const auto objectType = NetworkObject::Type(model->data(entryIndex, NetworkObjectModel::TypeRole).toInt());
+		const std::unique_ptr<NetworkObjectDirectory> directory{
+			VeyonCore::networkObjectDirectoryManager().createDirectory( Plugin::Uid{directoryUid}, nullptr ) };
+		if( directory == nullptr )
+		{
+			continue;
+		}
 
-		if( NetworkObject::isContainer(objectType) )
+		for( const auto& hostKey : hostKeys )
 		{
-			if (model->canFetchMore(entryIndex))
+			const auto hosts = directory->queryObjects( NetworkObject::Type::Host,
+														NetworkObject::Property::HostAddress, hostKey );
+			for( const auto& host : hosts )
 			{
-				model->fetchMore(entryIndex);
+				// not all directories return parents in the same order so prefer the direct parent
+				const auto parents = directory->queryParents( host );
+				auto parent = std::find_if( parents.begin(), parents.end(), [&host]( const NetworkObject& object ) {
+					return object.uid() == host.parentUid();
+				} );
+				if( parent == parents.end() )
+				{
+					parent = parents.begin();
+				}
+
+				if( parent == parents.end() )
+				{
+					continue;
+				}
+
+				auto locationName = parent->name();
+
+				// containers which have not been loaded yet may be referenced by their directory address only
+				// (e.g. the DN of an LDAP container) which never matches the location names shown in the tree
+				const auto directoryAddress = parent->property( NetworkObject::Property::DirectoryAddress ).toString();
+				if( directoryAddress.isEmpty() == false && locationName == directoryAddress )
+				{
+					const auto locations = directory->queryObjects( NetworkObject::Type::Location,
+																	NetworkObject::Property::DirectoryAddress,
+																	directoryAddress );
+					locationName = locations.isEmpty() ? QString{} : locations.first().name();
+				}
+
+				if( locationName.isEmpty() == false )
+				{
+					return { parent->uid(), locationName };
+				}
 			}
+		}
+	}
+
+	return {};
+}
 
-			const auto location = findLocationOfComputer( hostNames, hostAddresses, entryIndex );
-			if( location.isEmpty() == false )
+
+
+QStringList ComputerManager::normalizedHostKeys( const QStringList& hostNames, const QList<QHostAddress>& hostAddresses )
+{
+	QStringList hostKeys;
+
+	const auto addHostKeys = [&hostKeys]( const QString& host ) {
+		const HostAddress hostAddress( host );
+		for( const auto type : { HostAddress::Type::HostName,
+								 HostAddress::Type::FullyQualifiedDomainName,
+								 HostAddress::Type::IpAddress } )
+		{
+			const auto hostKey = hostAddress.tryConvert( type ).toLower();
+			if( hostKey.isEmpty() == false && hostKeys.contains( hostKey ) == false )
 			{
-				return location;
+				hostKeys.append( hostKey );
 			}
 		}
-		else if( objectType == NetworkObject::Type::Host )
-		{
-			QString currentHost = model->data( entryIndex, NetworkObjectModel::HostAddressRole ).toString().toLower();
-			QHostAddress currentHostAddress;
+	};
 
-			if( hostNames.contains( currentHost ) ||
-					( currentHostAddress.setAddress( currentHost ) && hostAddresses.contains( currentHostAddress ) ) )
-			{
-				return model->data( parent, NetworkObjectModel::NameRole ).toString();
-			}
+	for( const auto& hostName : hostNames )
+	{
+		addHostKeys( hostName );
+	}
+
+	for( const auto& hostAddress : hostAddresses )
+	{
+		addHostKeys( hostAddress.toString() );
+	}
+
+	return hostKeys;
+}
+
+
+
+QJsonArray ComputerManager::computersAtCurrentLocations() const
+{
+	QJsonArray computerUids;
+
+	for( const auto& location : std::as_const( m_currentLocations ) )
+	{
+		const auto computersAtLocation = getComputersAtLocation( location );
+		for( const auto& computer : computersAtLocation )
+		{
+			computerUids += computer.networkObjectUid().toString();
 		}
 	}
 
-	return {};
+	return computerUids;
 }
 
 
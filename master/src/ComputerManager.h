@@ -74,8 +74,18 @@ private:
 	void initComputerTreeModel();
 	void updateLocationFilterList();
 
-	QString findLocationOfComputer(const QStringList& hostNames, const QList<QHostAddress>& hostAddresses,
-								   const QModelIndex& parent) const;
+	struct DetectedLocation
+	{
+		NetworkObject::Uid uid{};
+		QString name{};
+	};
+
+	static DetectedLocation detectLocation(const QStringList& hostNames, const QList<QHostAddress>& hostAddresses);
+	static QStringList normalizedHostKeys(const QStringList& hostNames, const QList<QHostAddress>& hostAddresses);
+	void setCurrentLocation(const DetectedLocation& location);
+	void selectComputersAtCurrentLocations();
+	bool fetchLocation(const NetworkObject& location, QJsonArray& computerUids);
+	QJsonArray computersAtCurrentLocations() const;
 
 	ComputerList getComputersAtLocation(const QString& locationName, const QModelIndex& parent = {}, bool parentMatches = false) const;
 	bool hasSubLocations(const QModelIndex& index) const;
@@ -97,6 +107,8 @@ private:
 	NetworkObjectFilterProxyModel* m_networkObjectFilterProxyModel;
 
 	QStringList m_currentLocations;
+	NetworkObject::Uid m_currentLocationUid{};
+	bool m_computerSelectionModified{false};
 	QStringList m_locationFilterList;
 
 	QStringList m_localHostNames;
@@ -87,6 +87,38 @@ void ComputerMonitoringItem::runFeature( QString uid )
 
 
 
+void ComputerMonitoringItem::setVisibleRange( int first, int last )
+{
+	m_firstVisibleRow = first;
+	m_lastVisibleRow = last;
+
+	initiateVisibilityUpdate();
+}
+
+
+
+ComputerControlInterfaceList ComputerMonitoringItem::visibleComputerControlInterfaces() const
+{
+	ComputerControlInterfaceList computerControlInterfaces;
+
+	if( isVisible() == false || m_firstVisibleRow < 0 )
+	{
+		return computerControlInterfaces;
+	}
+
+	const auto lastRow = qMin( m_lastVisibleRow, dataModel()->rowCount() - 1 );
+
+	for( int row = m_firstVisibleRow; row <= lastRow; ++row )
+	{
+		computerControlInterfaces.append( dataModel()->data( dataModel()->index( row, 0 ), ComputerControlListModel::ControlInterfaceRole )
+											  .value<ComputerControlInterface::Pointer>() );
+	}
+
+	return computerControlInterfaces;
+}
+
+
+
 QObject* ComputerMonitoringItem::model() const
 {
 	return dataModel();
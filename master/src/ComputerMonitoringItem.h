@@ -62,6 +62,8 @@ public:
 
 	Q_INVOKABLE void runFeature( QString featureUid );
 
+	Q_INVOKABLE void setVisibleRange( int first, int last );
+
 private:
 	QObject* model() const;
 	QColor backgroundColor() const;
@@ -74,6 +76,8 @@ private:
 	void loadComputerPositions( const QJsonArray& positions ) override;
 	void setIconSize( const QSize& size ) override;
 
+	ComputerControlInterfaceList visibleComputerControlInterfaces() const override;
+
 	QVariantList selectedObjects() const;
 	void setSelectedObjects( const QVariantList& objects );
 
@@ -83,6 +87,9 @@ private:
 
 	QList<NetworkObject::Uid> m_selectedObjects;
 
+	int m_firstVisibleRow{-1};
+	int m_lastVisibleRow{-1};
+
 Q_SIGNALS:
 	void backgroundColorChanged();
 	void textColorChanged();
@@ -37,6 +37,14 @@ ComputerMonitoringModel::ComputerMonitoringModel( ComputerControlListModel* sour
 	new QAbstractItemModelTester( this, QAbstractItemModelTester::FailureReportingMode::Warning, this );
 #endif
 
+	m_updateTimer.setSingleShot( true );
+	m_updateTimer.setInterval( 0 );
+	connect( &m_updateTimer, &QTimer::timeout, this, &ComputerMonitoringModel::performPendingUpdates );
+
+	// frequent changes such as framebuffer updates must not trigger re-sorting or re-filtering
+	// all rows, therefore we evaluate the roles of changed data on our own
+	setDynamicSortFilter( false );
+
 	setSourceModel( sourceModel );
 	setFilterCaseSensitivity( Qt::CaseInsensitive );
 	setSortRole( Qt::InitialSortOrderRole );
@@ -44,6 +52,11 @@ ComputerMonitoringModel::ComputerMonitoringModel( ComputerControlListModel* sour
 	setUserLoginNameRole( ComputerControlListModel::UserLoginNameRole );
 	setGroupsRole( ComputerControlListModel::GroupsRole );
 	sort( 0 );
+
+	connect( sourceModel, &QAbstractItemModel::dataChanged,
+			 this, &ComputerMonitoringModel::handleSourceDataChanged );
+	connect( sourceModel, &QAbstractItemModel::rowsInserted,
+			 this, &ComputerMonitoringModel::scheduleSortUpdate );
 }
 
 
@@ -145,3 +158,83 @@ bool ComputerMonitoringModel::filterAcceptsRow( int sourceRow, const QModelIndex
 
 	return QSortFilterProxyModel::filterAcceptsRow( sourceRow, sourceParent );
 }
+
+
+
+void ComputerMonitoringModel::handleSourceDataChanged( const QModelIndex& topLeft, const QModelIndex& bottomRight,
+													  const QVector<int>& roles )
+{
+	Q_UNUSED(topLeft)
+	Q_UNUSED(bottomRight)
+
+	if( roles.isEmpty() )
+	{
+		scheduleFilterUpdate();
+		return;
+	}
+
+	for( const auto role : roles )
+	{
+		if( isFilterRole( role ) )
+		{
+			scheduleFilterUpdate();
+			return;
+		}
+
+		if( role == sortRole() )
+		{
+			scheduleSortUpdate();
+		}
+	}
+}
+
+
+
+bool ComputerMonitoringModel::isFilterRole( int role ) const
+{
+	// the search filter is set via setFilterRegExp() with older Qt versions (see ComputerMonitoringView)
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 1)
+	const auto hasSearchFilter = filterRegularExpression().pattern().isEmpty() == false;
+#else
+	const auto hasSearchFilter = filterRegExp().pattern().isEmpty() == false;
+#endif
+
+	return ( role == m_stateRole && m_stateFilter != ComputerControlInterface::State::None ) ||
+			( role == m_userLoginNameRole && m_filterNonEmptyUserLoginNames ) ||
+			( role == m_groupsRole && m_groupsFilter.isEmpty() == false ) ||
+			( role == filterRole() && hasSearchFilter );
+}
+
+
+
+void ComputerMonitoringModel::scheduleFilterUpdate()
+{
+	m_filterUpdatePending = true;
+	m_updateTimer.start();
+}
+
+
+
+void ComputerMonitoringModel::scheduleSortUpdate()
+{
+	m_sortUpdatePending = true;
+	m_updateTimer.start();
+}
+
+
+
+void ComputerMonitoringModel::performPendingUpdates()
+{
+	if( m_filterUpdatePending )
+	{
+		// rebuilds the mapping including sorting
+		invalidate();
+	}
+	else if( m_sortUpdatePending )
+	{
+		sort( sortColumn(), sortOrder() );
+	}
+
+	m_filterUpdatePending = false;
+	m_sortUpdatePending = false;
+}
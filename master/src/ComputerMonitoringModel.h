@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QSortFilterProxyModel>
+#include <QTimer>
 
 #include "ComputerControlInterface.h"
 
@@ -82,6 +83,13 @@ protected:
 	bool filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const override;
 
 private:
+	void handleSourceDataChanged( const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles );
+	bool isFilterRole( int role ) const;
+
+	void scheduleFilterUpdate();
+	void scheduleSortUpdate();
+	void performPendingUpdates();
+
 	int m_stateRole{-1};
 	int m_userLoginNameRole{-1};
 	int m_groupsRole{-1};
@@ -89,4 +97,10 @@ private:
 	bool m_filterNonEmptyUserLoginNames{false};
 	QSet<QString> m_groupsFilter;
 
+	// re-filtering and re-sorting is driven by handleSourceDataChanged() and only
+	// happens for changes of roles which actually affect filtering or sorting
+	QTimer m_updateTimer{this};
+	bool m_filterUpdatePending{false};
+	bool m_sortUpdatePending{false};
+
 };
@@ -40,6 +40,9 @@ ComputerMonitoringView::ComputerMonitoringView() :
 
 	m_iconSizeAutoAdjustTimer.setInterval( IconSizeAdjustDelay );
 	m_iconSizeAutoAdjustTimer.setSingleShot( true );
+
+	m_visibilityUpdateTimer.setInterval( VisibilityUpdateDelay );
+	m_visibilityUpdateTimer.setSingleShot( true );
 }
 
 
@@ -49,8 +52,13 @@ void ComputerMonitoringView::initializeView( QObject* self )
 	const auto autoAdjust = [this]() { initiateIconSizeAutoAdjust(); };
 
 	QObject::connect( &m_iconSizeAutoAdjustTimer, &QTimer::timeout, self, [this]() { performIconSizeAutoAdjust(); } );
+	QObject::connect( &m_visibilityUpdateTimer, &QTimer::timeout, self, [this, self]() {
+		m_master->computerControlListModel().setVisibleComputerControlInterfaces( self, visibleComputerControlInterfaces() );
+	} );
 	QObject::connect( dataModel(), &ComputerMonitoringModel::rowsInserted, self, autoAdjust );
 	QObject::connect( dataModel(), &ComputerMonitoringModel::rowsRemoved, self, autoAdjust );
+	QObject::connect( dataModel(), &ComputerMonitoringModel::layoutChanged, self, [this]() { initiateVisibilityUpdate(); } );
+	QObject::connect( dataModel(), &ComputerMonitoringModel::modelReset, self, [this]() { initiateVisibilityUpdate(); } );
 	QObject::connect( &m_master->computerControlListModel(), &ComputerControlListModel::computerScreenSizeChanged, self,
 					  [this]() { setIconSize( m_master->computerControlListModel().computerScreenSize() ); } );
 
@@ -194,6 +202,16 @@ void ComputerMonitoringView::initiateIconSizeAutoAdjust()
 
 
 
+void ComputerMonitoringView::initiateVisibilityUpdate()
+{
+	if( m_visibilityUpdateTimer.isActive() == false )
+	{
+		m_visibilityUpdateTimer.start();
+	}
+}
+
+
+
 void ComputerMonitoringView::runFeature( const Feature& feature )
 {
 	auto computerControlInterfaces = selectedComputerControlInterfaces();
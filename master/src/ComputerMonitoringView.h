@@ -43,6 +43,8 @@ public:
 	static constexpr auto IconSizeAdjustStepSize = 10;
 	static constexpr auto IconSizeAdjustDelay = 250;
 
+	static constexpr auto VisibilityUpdateDelay = 100;
+
 	ComputerMonitoringView();
 	virtual ~ComputerMonitoringView() = default;
 
@@ -87,6 +89,9 @@ protected:
 
 	void initiateIconSizeAutoAdjust();
 
+	virtual ComputerControlInterfaceList visibleComputerControlInterfaces() const = 0;
+	void initiateVisibilityUpdate();
+
 	VeyonMaster* master() const
 	{
 		return m_master;
@@ -104,4 +109,6 @@ private:
 	bool m_autoAdjustIconSize{false};
 	QTimer m_iconSizeAutoAdjustTimer{};
 
+	QTimer m_visibilityUpdateTimer{};
+
 };
@@ -89,6 +89,32 @@ ComputerControlInterfaceList ComputerMonitoringWidget::selectedComputerControlIn
 
 
 
+ComputerControlInterfaceList ComputerMonitoringWidget::visibleComputerControlInterfaces() const
+{
+	ComputerControlInterfaceList computerControlInterfaces;
+
+	if( isVisible() == false || model() == nullptr )
+	{
+		return computerControlInterfaces;
+	}
+
+	const auto viewportRect = viewport()->rect();
+
+	for( int row = 0, rowCount = model()->rowCount(); row < rowCount; ++row )
+	{
+		const auto index = model()->index( row, 0 );
+		if( visualRect( index ).intersects( viewportRect ) )
+		{
+			computerControlInterfaces.append( model()->data( index, ComputerControlListModel::ControlInterfaceRole )
+												  .value<ComputerControlInterface::Pointer>() );
+		}
+	}
+
+	return computerControlInterfaces;
+}
+
+
+
 bool ComputerMonitoringWidget::performIconSizeAutoAdjust()
 {
 	if( ComputerMonitoringView::performIconSizeAutoAdjust() == false)
@@ -395,6 +421,36 @@ void ComputerMonitoringWidget::showEvent( QShowEvent* event )
 	}
 
 	FlexibleListView::showEvent( event );
+
+	initiateVisibilityUpdate();
+}
+
+
+
+void ComputerMonitoringWidget::hideEvent( QHideEvent* event )
+{
+	FlexibleListView::hideEvent( event );
+
+	initiateVisibilityUpdate();
+}
+
+
+
+void ComputerMonitoringWidget::scrollContentsBy( int dx, int dy )
+{
+	FlexibleListView::scrollContentsBy( dx, dy );
+
+	initiateVisibilityUpdate();
+}
+
+
+
+void ComputerMonitoringWidget::updateGeometries()
+{
+	FlexibleListView::updateGeometries();
+
+	// called after (re)layouting items, e.g. after resizing or changes of the model
+	initiateVisibilityUpdate();
 }
 
 
@@ -65,6 +65,8 @@ private:
 
 	bool performIconSizeAutoAdjust() override;
 
+	ComputerControlInterfaceList visibleComputerControlInterfaces() const override;
+
 	void populateFeatureMenu( const ComputerControlInterfaceList& computerControlInterfaces );
 	void addFeatureToMenu( const Feature& feature, const QString& label );
 	void addSubFeaturesToMenu( const Feature& parentFeature, const FeatureList& subFeatures, const QString& label );
@@ -79,8 +81,12 @@ private:
 
 	void resizeEvent( QResizeEvent* event ) override;
 	void showEvent( QShowEvent* event ) override;
+	void hideEvent( QHideEvent* event ) override;
 	void wheelEvent( QWheelEvent* event ) override;
 
+	void scrollContentsBy( int dx, int dy ) override;
+	void updateGeometries() override;
+
 	QMenu* m_featureMenu{};
 	bool m_ignoreMousePressAndHoldEvent{false};
 	bool m_ignoreWheelEvent{false};
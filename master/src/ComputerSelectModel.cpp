@@ -23,6 +23,7 @@
  */
 
 #include "ComputerSelectModel.h"
+#include "NetworkObjectModel.h"
 #include "VeyonCore.h"
 
 #if defined(QT_TESTLIB_LIB) && QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
@@ -36,6 +37,13 @@ ComputerSelectModel::ComputerSelectModel( QAbstractItemModel* sourceModel, QObje
 	new QAbstractItemModelTester( this, QAbstractItemModelTester::FailureReportingMode::Warning, this );
 #endif
 
+	// connect before setting the source model so that cached search keys are invalidated
+	// before the changed rows are filtered again
+	connect( sourceModel, &QAbstractItemModel::dataChanged, this, &ComputerSelectModel::invalidateSearchKeys );
+	connect( sourceModel, &QAbstractItemModel::rowsRemoved, this, &ComputerSelectModel::resetSearchKeys );
+	connect( sourceModel, &QAbstractItemModel::modelReset, this, &ComputerSelectModel::resetSearchKeys );
+	connect( sourceModel, &QAbstractItemModel::layoutChanged, this, &ComputerSelectModel::resetSearchKeys );
+
 	setSourceModel( sourceModel );
 	setFilterCaseSensitivity( Qt::CaseInsensitive );
 	setFilterKeyColumn( -1 ); // filter all columns instead of first one only
@@ -53,3 +61,117 @@ QVariant ComputerSelectModel::value( const QModelIndex& index, const QString& ro
 {
 	return data( index, roleNames().key( role.toUtf8() ) );
 }
+
+
+
+void ComputerSelectModel::setSearchText( const QString& searchText )
+{
+	if( searchText.contains( QLatin1Char('*') ) ||
+		searchText.contains( QLatin1Char('?') ) ||
+		searchText.contains( QLatin1Char('[') ) )
+	{
+		m_searchText.clear();
+		m_rejectedUids.clear();
+		m_wildcardFilterActive = true;
+		setFilterWildcard( searchText );
+		return;
+	}
+
+	const auto lowerSearchText = searchText.toLower();
+	if( lowerSearchText == m_searchText && m_wildcardFilterActive == false )
+	{
+		return;
+	}
+
+	// objects not containing the previous search text can't contain an extended one either
+	if( m_searchText.isEmpty() || lowerSearchText.contains( m_searchText ) == false )
+	{
+		m_rejectedUids.clear();
+	}
+
+	m_searchText = lowerSearchText;
+
+	if( m_wildcardFilterActive )
+	{
+		m_wildcardFilterActive = false;
+		setFilterWildcard( {} );
+	}
+	else
+	{
+		invalidateFilter();
+	}
+}
+
+
+
+bool ComputerSelectModel::filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const
+{
+	if( m_searchText.isEmpty() )
+	{
+		return QSortFilterProxyModel::filterAcceptsRow( sourceRow, sourceParent );
+	}
+
+	const auto sourceIndex = sourceModel()->index( sourceRow, 0, sourceParent );
+	const auto uid = sourceModel()->data( sourceIndex, NetworkObjectModel::UidRole ).toUuid();
+
+	if( m_rejectedUids.contains( uid ) )
+	{
+		return false;
+	}
+
+	if( searchKey( sourceIndex, uid ).contains( m_searchText ) )
+	{
+		return true;
+	}
+
+	m_rejectedUids.insert( uid );
+
+	return false;
+}
+
+
+
+const QString& ComputerSelectModel::searchKey( const QModelIndex& sourceIndex, const NetworkObject::Uid& uid ) const
+{
+	auto it = m_searchKeys.find( uid );
+	if( it == m_searchKeys.end() )
+	{
+		QStringList texts;
+		const auto columnCount = sourceModel()->columnCount( sourceIndex.parent() );
+		for( int column = 0; column < columnCount; ++column )
+		{
+			texts.append( sourceModel()->data( sourceIndex.siblingAtColumn( column ) ).toString() );
+		}
+		texts.append( sourceModel()->data( sourceIndex, NetworkObjectModel::HostAddressRole ).toString() );
+
+		// join with a separator which can't be typed into the filter so matches never span columns
+		it = m_searchKeys.insert( uid, texts.join( QLatin1Char('\n') ).toLower() );
+	}
+
+	return it.value();
+}
+
+
+
+void ComputerSelectModel::invalidateSearchKeys( const QModelIndex& topLeft, const QModelIndex& bottomRight )
+{
+	if( m_searchKeys.isEmpty() && m_rejectedUids.isEmpty() )
+	{
+		return;
+	}
+
+	for( int row = topLeft.row(); row <= bottomRight.row(); ++row )
+	{
+		const auto uid = sourceModel()->data( topLeft.sibling( row, 0 ), NetworkObjectModel::UidRole ).toUuid();
+		m_searchKeys.remove( uid );
+		m_rejectedUids.remove( uid );
+	}
+}
+
+
+
+void ComputerSelectModel::resetSearchKeys()
+{
+	m_searchKeys.clear();
+	m_rejectedUids.clear();
+}
@@ -24,8 +24,11 @@
 
 #pragma once
 
+#include <QSet>
 #include <QSortFilterProxyModel>
 
+#include "NetworkObject.h"
+
 class ComputerSelectModel : public QSortFilterProxyModel
 {
 	Q_OBJECT
@@ -34,4 +37,26 @@ public:
 
 	Q_INVOKABLE QVariant value( const QModelIndex& index, const QString& role ) const;
 
+	// case-insensitive substring search over all columns and host addresses - texts containing
+	// wildcard characters are passed to setFilterWildcard() instead
+	void setSearchText( const QString& searchText );
+
+protected:
+	bool filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const override;
+
+private:
+	const QString& searchKey( const QModelIndex& sourceIndex, const NetworkObject::Uid& uid ) const;
+	void invalidateSearchKeys( const QModelIndex& topLeft, const QModelIndex& bottomRight );
+	void resetSearchKeys();
+
+	QString m_searchText;
+	bool m_wildcardFilterActive{false};
+
+	// lower-cased texts of all columns per object, built on first search
+	mutable QHash<NetworkObject::Uid, QString> m_searchKeys;
+
+	// objects known not to match m_searchText - stays valid while the search text only grows
+	// so typing further characters narrows the previous result instead of matching all objects again
+	mutable QSet<NetworkObject::Uid> m_rejectedUids;
+
 };
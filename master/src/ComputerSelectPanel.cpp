@@ -58,8 +58,14 @@ ComputerSelectPanel::ComputerSelectPanel( ComputerManager& computerManager, Comp
 
 	ui->filterLineEdit->setHidden( VeyonCore::config().hideComputerFilter() );
 
+	// only search once typing pauses - each keystroke restarts the timer and thus
+	// supersedes the search scheduled for the previous text
+	m_filterUpdateTimer.setSingleShot( true );
+	m_filterUpdateTimer.setInterval( FilterUpdateDelay );
+	connect( &m_filterUpdateTimer, &QTimer::timeout, this, &ComputerSelectPanel::updateFilter );
+
 	connect( ui->filterLineEdit, &QLineEdit::textChanged,
-			 this, &ComputerSelectPanel::updateFilter );
+			 this, &ComputerSelectPanel::scheduleFilterUpdate );
 
 	if (VeyonCore::config().expandLocations())
 	{
@@ -136,6 +142,22 @@ void ComputerSelectPanel::saveList()
 
 
 
+void ComputerSelectPanel::scheduleFilterUpdate()
+{
+	// restore the unfiltered tree immediately when the filter is cleared
+	if( ui->filterLineEdit->text().isEmpty() )
+	{
+		m_filterUpdateTimer.stop();
+		updateFilter();
+	}
+	else
+	{
+		m_filterUpdateTimer.start();
+	}
+}
+
+
+
 void ComputerSelectPanel::updateFilter()
 {
 	const auto filter = ui->filterLineEdit->text();
@@ -143,7 +165,7 @@ void ComputerSelectPanel::updateFilter()
 
 	if( filter.isEmpty() )
 	{
-		m_model->setFilterWildcard( filter );
+		m_model->setSearchText( filter );
 
 		for( int i = 0; i < model->rowCount(); ++i )
 		{
@@ -171,7 +193,7 @@ void ComputerSelectPanel::updateFilter()
 
 		m_previousFilter = filter;
 
-		m_model->setFilterWildcard( filter );
+		m_model->setSearchText( filter );
 		ui->treeView->expandAll();
 	}
 }
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QModelIndexList>
+#include <QTimer>
 #include <QWidget>
 
 namespace Ui {
@@ -50,6 +51,9 @@ private Q_SLOTS:
 	void updateFilter();
 
 private:
+	static constexpr int FilterUpdateDelay = 150;
+
+	void scheduleFilterUpdate();
 	void fetchAndExpandAll();
 	void fetchAll(const QModelIndex& index);
 
@@ -57,6 +61,7 @@ private:
 	ComputerManager& m_computerManager;
 	ComputerSelectModel* m_model;
 	QString m_previousFilter;
+	QTimer m_filterUpdateTimer{this};
 	QModelIndexList m_expandedGroups;
 
 };
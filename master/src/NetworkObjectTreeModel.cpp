@@ -48,8 +48,8 @@ NetworkObjectTreeModel::NetworkObjectTreeModel( NetworkObjectDirectory* director
 	connect( m_directory, &NetworkObjectDirectory::objectsRemoved,
 			 this, &NetworkObjectTreeModel::endRemoveObjects );
 
-	connect( m_directory, &NetworkObjectDirectory::objectChanged,
-			 this, &NetworkObjectTreeModel::updateObject );
+	connect( m_directory, &NetworkObjectDirectory::objectsChanged,
+			 this, &NetworkObjectTreeModel::updateObjects );
 }
 
 
@@ -254,11 +254,12 @@ void NetworkObjectTreeModel::endRemoveObjects()
 
 
 
-void NetworkObjectTreeModel::updateObject(NetworkObject::ModelId parentId, int row)
+void NetworkObjectTreeModel::updateObjects(NetworkObject::ModelId parentId, int index, int count)
 {
-	const auto index = createIndex(row, 0, parentId);
+	const auto lastIndex = index + count - 1;
 
-	Q_EMIT dataChanged( index, index );
+	Q_EMIT dataChanged(createIndex(index, 0, m_directory->childId(parentId, index)),
+					   createIndex(lastIndex, 0, m_directory->childId(parentId, lastIndex)));
 }
 
 
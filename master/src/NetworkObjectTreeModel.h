@@ -58,7 +58,7 @@ private:
 	void beginRemoveObjects(NetworkObject::ModelId parentId, int index, int count);
 	void endRemoveObjects();
 
-	void updateObject(NetworkObject::ModelId parent, int index );
+	void updateObjects(NetworkObject::ModelId parentId, int index, int count);
 
 	QModelIndex objectIndex( NetworkObject::ModelId object, int column = 0 ) const;
 	const NetworkObject& object( const QModelIndex& index ) const;
@@ -0,0 +1,78 @@
+/*
+ * ScaledFramebufferCache.cpp - implementation of ScaledFramebufferCache
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#include <QAbstractItemModel>
+
+#include "ComputerListModel.h"
+#include "ScaledFramebufferCache.h"
+
+
+QImage ScaledFramebufferCache::scaledFramebuffer( const QAbstractItemModel* model, const QModelIndex& index, QSize size )
+{
+	const auto controlInterface = model->data( index, ComputerListModel::ControlInterfaceRole )
+									  .value<ComputerControlInterface::Pointer>();
+
+	if( controlInterface )
+	{
+		const auto it = m_entries.constFind( controlInterface.data() );
+		if( it != m_entries.constEnd() &&
+			it->controlInterface == controlInterface &&
+			it->timestamp == controlInterface->timestamp() &&
+			it->state == controlInterface->state() &&
+			it->size == size )
+		{
+			return it->image;
+		}
+	}
+
+	auto framebuffer = model->data( index, ComputerListModel::FramebufferRole ).value<QImage>();
+	if( framebuffer.isNull() )
+	{
+		framebuffer = model->data( index, Qt::DecorationRole ).value<QImage>();
+	}
+
+	const auto image = framebuffer.scaled( size, Qt::KeepAspectRatio, Qt::SmoothTransformation );
+
+	if( controlInterface )
+	{
+		m_entries[controlInterface.data()] = { controlInterface, controlInterface->timestamp(),
+												controlInterface->state(), size, image };
+	}
+
+	return image;
+}
+
+
+
+void ScaledFramebufferCache::remove( const ComputerControlInterface::Pointer& controlInterface )
+{
+	m_entries.remove( controlInterface.data() );
+}
+
+
+
+void ScaledFramebufferCache::clear()
+{
+	m_entries.clear();
+}
@@ -0,0 +1,57 @@
+/*
+ * ScaledFramebufferCache.h - header file for ScaledFramebufferCache
+ *
+ * Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+ *
+ * This file is part of Veyon - https://veyon.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ *
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QImage>
+
+#include "ComputerControlInterface.h"
+
+class QAbstractItemModel;
+class QModelIndex;
+
+class ScaledFramebufferCache
+{
+public:
+	// returns the framebuffer (or decoration as fallback) of the given index scaled to the given size,
+	// rescaling only if the computer's timestamp, state or the size changed since the last call
+	QImage scaledFramebuffer( const QAbstractItemModel* model, const QModelIndex& index, QSize size );
+
+	void remove( const ComputerControlInterface::Pointer& controlInterface );
+	void clear();
+
+private:
+	struct Entry
+	{
+		QWeakPointer<ComputerControlInterface> controlInterface;
+		int timestamp;
+		ComputerControlInterface::State state;
+		QSize size;
+		QImage image;
+	};
+
+	QHash<const ComputerControlInterface *, Entry> m_entries;
+
+};
@@ -57,6 +57,13 @@ SlideshowModel::SlideshowModel( QAbstractItemModel* sourceModel, QObject* parent
 
 
 
+SlideshowModel::~SlideshowModel()
+{
+	setCurrentControlInterface( {} );
+}
+
+
+
 void SlideshowModel::setIconSize( QSize size )
 {
 	m_iconSize = size;
@@ -81,13 +88,7 @@ QVariant SlideshowModel::data( const QModelIndex& index, int role ) const
 
 	if( role == Qt::DecorationRole )
 	{
-		auto framebuffer = sourceModel()->data(sourceIndex, ComputerListModel::FramebufferRole).value<QImage>();
-		if (framebuffer.isNull())
-		{
-			framebuffer = sourceModel()->data(sourceIndex, Qt::DecorationRole).value<QImage>();
-		}
-
-		return framebuffer.scaled(m_iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+		return m_scaledFramebufferCache.scaledFramebuffer( sourceModel(), sourceIndex, m_iconSize );
 	}
 
 	return QSortFilterProxyModel::data( index, role );
@@ -128,7 +129,7 @@ void SlideshowModel::showPrevious()
 	if( valid == false )
 	{
 		m_currentRow = 0;
-		m_currentControlInterface.clear();
+		setCurrentControlInterface( {} );
 	}
 
 	if( m_timer.isActive() )
@@ -160,7 +161,7 @@ void SlideshowModel::showNext()
 	if( valid == false )
 	{
 		m_currentRow = 0;
-		m_currentControlInterface.clear();
+		setCurrentControlInterface( {} );
 	}
 
 	if( m_timer.isActive() )
@@ -188,18 +189,21 @@ void SlideshowModel::setCurrentRow( int row )
 	beginFilterChange();
 #endif
 
+	// only the current computer is displayed so there's no need to keep frames of other computers
+	m_scaledFramebufferCache.clear();
+
 	if( sourceModel()->rowCount() > 0 )
 	{
 		m_currentRow = qMax( 0, row ) % qMax( 1, sourceModel()->rowCount() );
 
-		m_currentControlInterface = sourceModel()->data( sourceModel()->index( m_currentRow, 0 ),
+		setCurrentControlInterface( sourceModel()->data( sourceModel()->index( m_currentRow, 0 ),
 														 ComputerListModel::ControlInterfaceRole )
-										.value<ComputerControlInterface::Pointer>();
+										.value<ComputerControlInterface::Pointer>() );
 	}
 	else
 	{
 		m_currentRow = 0;
-		m_currentControlInterface.clear();
+		setCurrentControlInterface( {} );
 	}
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 10, 0)
@@ -210,3 +214,21 @@ void SlideshowModel::setCurrentRow( int row )
 	invalidateFilter();
 #endif
 }
+
+
+
+void SlideshowModel::setCurrentControlInterface( const ComputerControlInterface::Pointer& controlInterface )
+{
+	if( m_currentControlInterface )
+	{
+		m_currentControlInterface->setFramebufferInUse( this, false );
+	}
+
+	m_currentControlInterface = controlInterface;
+
+	// the displayed computer may not be visible in any other view and thus have its updates suspended
+	if( m_currentControlInterface )
+	{
+		m_currentControlInterface->setFramebufferInUse( this, true );
+	}
+}
@@ -28,12 +28,14 @@
 #include <QTimer>
 
 #include "ComputerControlInterface.h"
+#include "ScaledFramebufferCache.h"
 
 class SlideshowModel : public QSortFilterProxyModel
 {
 	Q_OBJECT
 public:
 	SlideshowModel( QAbstractItemModel* sourceModel, QObject* parent = nullptr );
+	~SlideshowModel() override;
 
 	void setIconSize( QSize size );
 
@@ -49,8 +51,10 @@ protected:
 
 private:
 	void setCurrentRow( int row );
+	void setCurrentControlInterface( const ComputerControlInterface::Pointer& controlInterface );
 
 	QSize m_iconSize;
+	mutable ScaledFramebufferCache m_scaledFramebufferCache;
 
 	QTimer m_timer;
 
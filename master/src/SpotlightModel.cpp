@@ -33,6 +33,16 @@ SpotlightModel::SpotlightModel( QAbstractItemModel* sourceModel, QObject* parent
 
 
 
+SpotlightModel::~SpotlightModel()
+{
+	for( const auto& controlInterface : std::as_const(m_controlInterfaces) )
+	{
+		controlInterface->setFramebufferInUse( this, false );
+	}
+}
+
+
+
 void SpotlightModel::setIconSize( QSize size )
 {
 	m_iconSize = size;
@@ -64,6 +74,8 @@ void SpotlightModel::add( const ComputerControlInterface::Pointer& controlInterf
 
 	m_controlInterfaces.append( controlInterface );
 
+	controlInterface->setFramebufferInUse( this, true );
+
 	controlInterface->setUpdateMode( m_updateInRealtime
 										 ? ComputerControlInterface::UpdateMode::Live
 										 : ComputerControlInterface::UpdateMode::Monitoring );
@@ -86,6 +98,9 @@ void SpotlightModel::remove( const ComputerControlInterface::Pointer& controlInt
 #endif
 
 	m_controlInterfaces.removeAll( controlInterface );
+	m_scaledFramebufferCache.remove( controlInterface );
+
+	controlInterface->setFramebufferInUse( this, false );
 
 	controlInterface->setUpdateMode( ComputerControlInterface::UpdateMode::Monitoring );
 
@@ -110,13 +125,7 @@ QVariant SpotlightModel::data( const QModelIndex& index, int role ) const
 
 	if( role == Qt::DecorationRole )
 	{
-		auto framebuffer = sourceModel()->data(sourceIndex, ComputerListModel::FramebufferRole).value<QImage>();
-		if (framebuffer.isNull())
-		{
-			framebuffer = sourceModel()->data(sourceIndex, Qt::DecorationRole).value<QImage>();
-		}
-
-		return framebuffer.scaled(m_iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+		return m_scaledFramebufferCache.scaledFramebuffer( sourceModel(), sourceIndex, m_iconSize );
 	}
 
 	return QSortFilterProxyModel::data( index, role );
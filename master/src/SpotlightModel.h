@@ -27,6 +27,7 @@
 #include <QSortFilterProxyModel>
 
 #include "ComputerControlListModel.h"
+#include "ScaledFramebufferCache.h"
 
 class SpotlightModel : public QSortFilterProxyModel
 {
@@ -35,6 +36,7 @@ public:
 	static constexpr auto ControlInterfaceRole = ComputerControlListModel::ControlInterfaceRole;
 
 	SpotlightModel( QAbstractItemModel* sourceModel, QObject* parent = nullptr );
+	~SpotlightModel() override;
 
 	void setIconSize( QSize size );
 	void setUpdateInRealtime( bool enabled );
@@ -49,6 +51,7 @@ protected:
 
 private:
 	QSize m_iconSize;
+	mutable ScaledFramebufferCache m_scaledFramebufferCache;
 	bool m_updateInRealtime{false};
 
 	ComputerControlInterfaceList m_controlInterfaces;
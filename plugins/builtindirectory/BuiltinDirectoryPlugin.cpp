@@ -22,6 +22,8 @@
  *
  */
 
+#include <algorithm>
+
 #include <QFile>
 #include <QRegularExpression>
 
@@ -102,11 +104,14 @@ CommandLinePluginInterface::RunResult BuiltinDirectoryPlugin::handle_help( const
 		printUsage( commandLineModuleName(), importCommand(), { { tr("FILE"), {} } }, {
 						{ tr("LOCATION"), locationArgument() },
 						{ tr("FORMAT-STRING-WITH-PLACEHOLDERS"), formatArgument() },
-						{ tr("REGULAR-EXPRESSION-WITH-PLACEHOLDER"), regexArgument() } } );
+						{ tr("REGULAR-EXPRESSION-WITH-PLACEHOLDER"), regexArgument() },
+						{ dryRunArgument(), {} } } );
 
 		printDescription( tr("Imports objects from the specified text file using the given format string or "
 							 "regular expression containing one or multiple placeholders. "
-							 "Valid placeholders are: %1").arg( importExportPlaceholders().join(QLatin1Char(' ') ) ) );
+							 "Valid placeholders are: %1").arg( importExportPlaceholders().join(QLatin1Char(' ') ) ) + QLatin1Char(' ') +
+						  tr("Existing computers with the same name in the same location are updated. "
+							 "With \"%1\" the changes are only listed but not saved.").arg( dryRunArgument() ) );
 
 		printExamples( commandLineModuleName(), importCommand(), {
 						   { tr( "Import simple CSV file to a single room" ),
@@ -350,16 +355,23 @@ CommandLinePluginInterface::RunResult BuiltinDirectoryPlugin::handle_import( con
 	QString location;
 	QString formatString;
 	QString regularExpression;
+	bool dryRun = false;
 
-	for( int i = 1; i < arguments.count(); i += 2 )
+	for( int i = 1; i < arguments.count(); ++i )
 	{
+		const auto key = arguments[i];
+		if( key == dryRunArgument() )
+		{
+			dryRun = true;
+			continue;
+		}
+
 		if( i+1 >= arguments.count() )
 		{
 			return NotEnoughArguments;
 		}
 
-		const auto key = arguments[i];
-		const auto value = arguments[i+1];
+		const auto value = arguments[++i];
 		if( key == locationArgument() )
 		{
 			location = value;
@@ -379,31 +391,25 @@ CommandLinePluginInterface::RunResult BuiltinDirectoryPlugin::handle_import( con
 		}
 	}
 
-	if( formatString.isEmpty() == false )
+	if( formatString.isEmpty() && regularExpression.isEmpty() )
 	{
-		regularExpression = formatString;
-
-		const auto placeholders = importExportPlaceholders();
-
-		for( const auto& placeholder : placeholders )
-		{
-			regularExpression.replace( placeholder, QStringLiteral("(%1:[^\\n\\r]*)").arg( placeholder ) );
-		}
+		error( tr("No format string or regular expression specified!") );
+		return InvalidArguments;
 	}
 
-	if( regularExpression.isEmpty() == false )
+	const auto format = importFormat( formatString, regularExpression );
+	if( format.regularExpression.isValid() == false )
 	{
-		if( importFile( inputFile, regularExpression, location ) )
-		{
-			return saveConfiguration();
-		}
+		error( tr("Invalid regular expression: %1").arg( format.regularExpression.errorString() ) );
+		return InvalidArguments;
+	}
 
+	if( importFile( inputFile, format, location, dryRun ) == false )
+	{
 		return Failed;
 	}
 
-	error( tr("No format string or regular expression specified!") );
-
-	return InvalidArguments;
+	return dryRun ? Successful : saveConfiguration();
 }
 
 
@@ -576,12 +582,129 @@ CommandLinePluginInterface::RunResult BuiltinDirectoryPlugin::saveConfiguration(
 
 
 
-bool BuiltinDirectoryPlugin::importFile( QFile& inputFile,
-										 const QString& regExWithPlaceholders,
-										 const QString& location )
+BuiltinDirectoryPlugin::ImportFormat BuiltinDirectoryPlugin::importFormat( const QString& formatString,
+																		   const QString& regExWithPlaceholders )
 {
+	ImportFormat format;
+
+	auto rxString = regExWithPlaceholders;
+
+	if( formatString.isEmpty() == false )
+	{
+		rxString = formatString;
+
+		const auto placeholders = importExportPlaceholders();
+
+		for( const auto& placeholder : placeholders )
+		{
+			rxString.replace( placeholder, QStringLiteral("(%1:[^\\n\\r]*)").arg( placeholder ) );
+		}
+
+		// simple formats such as "%name%;%host%;%mac%" can be parsed by splitting lines
+		// at the separator instead of matching the regular expression
+		static const QRegularExpression separatorRX{QStringLiteral("^%\\w+%([^\\w%\\\\^$.|?*+()\\[\\]{}])")};
+		const auto separatorMatch = separatorRX.match( formatString );
+		if( separatorMatch.hasMatch() )
+		{
+			const auto separator = separatorMatch.captured( 1 ).at( 0 );
+			const auto fields = formatString.split( separator );
+			if( std::all_of( fields.begin(), fields.end(),
+							 [&placeholders]( const QString& field ) { return placeholders.contains( field ); } ) )
+			{
+				format.separator = separator;
+			}
+		}
+	}
+
+	static const QRegularExpression varDetectionRX{QStringLiteral("\\((%\\w+%):[^)]+\\)")};
+	auto varDetectionMatchIterator = varDetectionRX.globalMatch( rxString );
+
+	while( varDetectionMatchIterator.hasNext() )
+	{
+		format.placeholders.append( varDetectionMatchIterator.next().captured(1) );
+	}
+
+	for( const auto& var : std::as_const(format.placeholders) )
+	{
+		rxString.replace( QStringLiteral("%1:").arg( var ), QString() );
+	}
+
+	format.regularExpression.setPattern( rxString );
+	format.regularExpression.optimize();
+
+	format.typeIndex = format.placeholders.indexOf( QStringLiteral("%type%") );
+	format.locationIndex = format.placeholders.indexOf( QStringLiteral("%location%") );
+	format.nameIndex = format.placeholders.indexOf( QStringLiteral("%name%") );
+	format.hostIndex = format.placeholders.indexOf( QStringLiteral("%host%") );
+	format.macIndex = format.placeholders.indexOf( QStringLiteral("%mac%") );
+
+	return format;
+}
+
+
+
+bool BuiltinDirectoryPlugin::importFile( QFile& inputFile, const ImportFormat& format,
+										 const QString& location, bool dryRun )
+{
+	auto objects = m_configuration.networkObjects();
+
+	// index existing objects once so that each imported line only requires hash lookups
+	QHash<NetworkObject::Uid, int> objectIndexes;
+	QHash<QString, NetworkObject::Uid> locationUids;
+	QHash<QPair<NetworkObject::Uid, QString>, int> computerIndexes;
+
+	objectIndexes.reserve( objects.size() );
+
+	for( int i = 0; i < objects.size(); ++i )
+	{
+		const NetworkObject object{objects[i].toObject()};
+		objectIndexes.insert( object.uid(), i );
+		if( object.type() == NetworkObject::Type::Location && locationUids.contains( object.name() ) == false )
+		{
+			locationUids.insert( object.name(), object.uid() );
+		}
+		else if( object.type() == NetworkObject::Type::Host )
+		{
+			computerIndexes.insert( { object.parentUid(), object.name() }, i );
+		}
+	}
+
+	TableRows changes;
+	int unchangedCount = 0;
+
+	const auto addChange = [&changes]( const QString& action, const NetworkObject& object, const QString& locationName ) {
+		changes.append( { action, networkObjectTypeName( object ), object.name(), locationName,
+						  object.property( NetworkObject::Property::HostAddress ).toString(),
+						  object.property( NetworkObject::Property::MacAddress ).toString() } );
+	};
+
+	const auto appendObject = [&]( const NetworkObject& object ) {
+		objectIndexes.insert( object.uid(), int( objects.size() ) );
+		objects.append( object.toJson() );
+	};
+
+	const auto locationUid = [&]( const QString& locationName ) -> NetworkObject::Uid {
+		if( locationName.isEmpty() )
+		{
+			return {};
+		}
+
+		const auto it = locationUids.constFind( locationName );
+		if( it != locationUids.constEnd() )
+		{
+			return it.value();
+		}
+
+		const NetworkObject locationObject{nullptr, NetworkObject::Type::Location, locationName};
+		appendObject( locationObject );
+		locationUids.insert( locationName, locationObject.uid() );
+		addChange( tr("add"), locationObject, {} );
+
+		return locationObject.uid();
+	};
+
 	int lineCount = 0;
-	QMap<QString, NetworkObjectList > networkObjects;
+
 	while( inputFile.atEnd() == false )
 	{
 		++lineCount;
@@ -589,48 +712,72 @@ bool BuiltinDirectoryPlugin::importFile( QFile& inputFile,
 		auto targetLocation = location;
 
 		const auto line = inputFile.readLine();
-		const auto networkObject = toNetworkObject( QString::fromUtf8( line ), regExWithPlaceholders, targetLocation );
+		const auto networkObject = toNetworkObject( QString::fromUtf8( line ), format, targetLocation );
 
-		if( networkObject.isValid() )
-		{
-			networkObjects[targetLocation].append( networkObject );
-		}
-		else
+		if( networkObject.isValid() == false )
 		{
 			error( tr( "Error while parsing line %1." ).arg( lineCount ) );
 			return false;
 		}
-	}
 
-	ObjectManager<NetworkObject> objectManager( m_configuration.networkObjects() );
+		const auto parentUid = locationUid( targetLocation );
 
-	for( auto it = networkObjects.constBegin(), end = networkObjects.constEnd(); it != end; ++it )
-	{
-		auto parentLocation = objectManager.findByName( it.key() );
-		auto parentLocationUid = parentLocation.uid();
-		if( it.key().isEmpty() )
+		if( networkObject.type() == NetworkObject::Type::Location )
 		{
-			parentLocationUid = QUuid();
+			if( locationUids.contains( networkObject.name() ) )
+			{
+				++unchangedCount;
+				continue;
+			}
+
+			const NetworkObject locationObject{nullptr, NetworkObject::Type::Location, networkObject.name(),
+											   {}, {}, parentUid};
+			appendObject( locationObject );
+			locationUids.insert( locationObject.name(), locationObject.uid() );
+			addChange( tr("add"), locationObject, targetLocation );
+			continue;
 		}
-		else if( parentLocation.isValid() == false )
+
+		NetworkObject computerObject{nullptr, networkObject.type(), networkObject.name(),
+									 networkObject.properties(), {}, parentUid};
+
+		if( objectIndexes.contains( computerObject.uid() ) )
 		{
-			parentLocation = NetworkObject( nullptr, NetworkObject::Type::Location, it.key() );
-			objectManager.update( parentLocation, true );
-			parentLocationUid = parentLocation.uid();
+			// UID is derived from all attributes so nothing has changed
+			++unchangedCount;
+			continue;
 		}
 
-		for( const NetworkObject& networkObject : std::as_const(it.value()) )
+		const auto existingIndex = computerIndexes.value( { parentUid, computerObject.name() }, -1 );
+		if( existingIndex >= 0 )
 		{
-			objectManager.update( NetworkObject( nullptr,
-												 networkObject.type(),
-												 networkObject.name(),
-												 networkObject.properties(),
-												 {},
-												 parentLocationUid ), true );
+			// keep UID of existing computer so references to it remain valid
+			const NetworkObject existingObject{objects[existingIndex].toObject()};
+			computerObject = NetworkObject{nullptr, computerObject.type(), computerObject.name(),
+										   computerObject.properties(), existingObject.uid(), parentUid};
+
+			objects.replace( existingIndex, computerObject.toJson() );
+			addChange( tr("update"), computerObject, targetLocation );
+			continue;
 		}
+
+		computerIndexes.insert( { parentUid, computerObject.name() }, int( objects.size() ) );
+		appendObject( computerObject );
+		addChange( tr("add"), computerObject, targetLocation );
 	}
 
-	m_configuration.setNetworkObjects( objectManager.objects() );
+	if( dryRun )
+	{
+		printTable( Table( { tr("Action"), tr("Type"), tr("Name"), tr("Location"), tr("Host address"), tr("MAC address") },
+						   changes ) );
+	}
+	else
+	{
+		m_configuration.setNetworkObjects( objects );
+	}
+
+	info( tr( "%1 lines processed, %2 objects added or updated, %3 objects unchanged." )
+			  .arg( lineCount ).arg( changes.count() ).arg( unchangedCount ) );
 
 	return true;
 }
@@ -707,70 +854,79 @@ NetworkObject BuiltinDirectoryPlugin::findNetworkObject( const QString& uidOrNam
 
 
 
-NetworkObject BuiltinDirectoryPlugin::toNetworkObject( const QString& line, const QString& regExWithPlaceholders,
+NetworkObject BuiltinDirectoryPlugin::toNetworkObject( const QString& line, const ImportFormat& format,
 													   QString& location )
 {
-	QStringList placeholders;
-	static const QRegularExpression varDetectionRX{QStringLiteral("\\((%\\w+%):[^)]+\\)")};
-	auto varDetectionMatchIterator = varDetectionRX.globalMatch(regExWithPlaceholders);
-
-	while( varDetectionMatchIterator.hasNext() )
-	{
-		placeholders.append( varDetectionMatchIterator.next().captured(1) );
-	}
+	QStringList fields;
+	auto parsed = false;
 
-	QString rxString = regExWithPlaceholders;
-	for( const auto& var : std::as_const(placeholders) )
+	if( format.separator.isNull() == false )
 	{
-		rxString.replace( QStringLiteral("%1:").arg( var ), QString() );
-	}
-
-	auto match = QRegularExpression( rxString ).match( line );
-	if( match.hasMatch() )
-	{
-		auto objectType = NetworkObject::Type::Host;
-		const auto typeIndex = placeholders.indexOf( QStringLiteral("%type%") );
-		if( typeIndex != -1 )
+		auto end = line.size();
+		while( end > 0 && ( line[end-1] == QLatin1Char('\n') || line[end-1] == QLatin1Char('\r') ) )
 		{
-			objectType = parseNetworkObjectType( match.captured( 1 + typeIndex ) );
+			--end;
 		}
 
-		const auto locationIndex = placeholders.indexOf( QStringLiteral("%location%") );
-		const auto nameIndex = placeholders.indexOf( QStringLiteral("%name%") );
-		const auto hostIndex = placeholders.indexOf( QStringLiteral("%host%") );
-		const auto macIndex = placeholders.indexOf( QStringLiteral("%mac%") );
+		fields = line.left( end ).split( format.separator );
 
-		auto name = ( nameIndex != -1 ) ? match.captured( 1 + nameIndex ).trimmed() : QString();
-		auto host = ( hostIndex != -1 ) ? match.captured( 1 + hostIndex ).trimmed() : QString();
-		auto mac = ( macIndex != -1 ) ? match.captured( 1 + macIndex ).trimmed() : QString();
+		// lines with additional separators are handled by the regular expression as before
+		parsed = fields.count() == format.placeholders.count();
+	}
 
-		if( objectType == NetworkObject::Type::Location )
+	if( parsed == false )
+	{
+		const auto match = format.regularExpression.match( line );
+		if( match.hasMatch() == false )
 		{
-			return NetworkObject( nullptr, NetworkObject::Type::Location, name );
+			return NetworkObject{};
 		}
 
-		if( location.isEmpty() && locationIndex != -1 )
+		fields.clear();
+		for( int i = 0; i < format.placeholders.count(); ++i )
 		{
-			location = match.captured( 1 + locationIndex ).trimmed();
+			fields.append( match.captured( 1 + i ) );
 		}
+	}
 
-		if( host.isEmpty() )
-		{
-			host = name;
-		}
-		else if( name.isEmpty() )
-		{
-			name = host;
-		}
-		return NetworkObject( nullptr,
-							  NetworkObject::Type::Host, name,
-							  {
-								  { NetworkObject::propertyKey(NetworkObject::Property::HostAddress), host },
-								  { NetworkObject::propertyKey(NetworkObject::Property::MacAddress), mac }
-							  } );
+	const auto field = [&fields]( int index ) {
+		return index != -1 ? fields.value( index ).trimmed() : QString();
+	};
+
+	auto objectType = NetworkObject::Type::Host;
+	if( format.typeIndex != -1 )
+	{
+		objectType = parseNetworkObjectType( fields.value( format.typeIndex ) );
 	}
 
-	return NetworkObject{};
+	auto name = field( format.nameIndex );
+	auto host = field( format.hostIndex );
+	const auto mac = field( format.macIndex );
+
+	if( objectType == NetworkObject::Type::Location )
+	{
+		return NetworkObject( nullptr, NetworkObject::Type::Location, name );
+	}
+
+	if( location.isEmpty() && format.locationIndex != -1 )
+	{
+		location = field( format.locationIndex );
+	}
+
+	if( host.isEmpty() )
+	{
+		host = name;
+	}
+	else if( name.isEmpty() )
+	{
+		name = host;
+	}
+	return NetworkObject( nullptr,
+						  NetworkObject::Type::Host, name,
+						  {
+							  { NetworkObject::propertyKey(NetworkObject::Property::HostAddress), host },
+							  { NetworkObject::propertyKey(NetworkObject::Property::MacAddress), mac }
+						  } );
 }
 
 
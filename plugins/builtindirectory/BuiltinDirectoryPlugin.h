@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <QRegularExpression>
+
 #include "CommandLinePluginInterface.h"
 #include "CommandLineIO.h"
 #include "BuiltinDirectoryConfiguration.h"
@@ -125,12 +127,26 @@ private:
 
 	CommandLinePluginInterface::RunResult saveConfiguration();
 
-	bool importFile( QFile& inputFile, const QString& regExWithVariables, const QString& location );
+	struct ImportFormat
+	{
+		QRegularExpression regularExpression;
+		QStringList placeholders{}; // in order of capture groups and fields
+		QChar separator{}; // set if the format string solely consists of placeholders joined by a separator
+		int typeIndex{-1};
+		int locationIndex{-1};
+		int nameIndex{-1};
+		int hostIndex{-1};
+		int macIndex{-1};
+	};
+
+	static ImportFormat importFormat( const QString& formatString, const QString& regExWithPlaceholders );
+
+	bool importFile( QFile& inputFile, const ImportFormat& format, const QString& location, bool dryRun );
 	bool exportFile( QFile& outputFile, const QString& formatString, const QString& location );
 
 	NetworkObject findNetworkObject( const QString& uidOrName ) const;
 
-	static NetworkObject toNetworkObject( const QString& line, const QString& regExWithVariables, QString& location );
+	static NetworkObject toNetworkObject( const QString& line, const ImportFormat& format, QString& location );
 	static QString toFormattedString( const NetworkObject& networkObject, const QString& formatString, const QString& location );
 
 	static QStringList importExportPlaceholders();
@@ -185,6 +201,11 @@ private:
 		return QStringLiteral("regex");
 	}
 
+	static QString dryRunArgument()
+	{
+		return QStringLiteral("dry-run");
+	}
+
 	static QString typeLocation()
 	{
 		return QStringLiteral("location");
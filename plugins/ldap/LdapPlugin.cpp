@@ -14,6 +14,7 @@
 #include "LdapConfigurationPage.h"
 #include "LdapConfigurationTest.h"
 #include "LdapDirectory.h"
+#include "LdapQueryCache.h"
 #include "LdapNetworkObjectDirectoryConfigurationPage.h"
 #include "VariantArrayMessage.h"
 #include "VeyonConfiguration.h"
@@ -25,8 +26,10 @@ LdapPlugin::LdapPlugin( QObject* parent ) :
 	m_ldapDirectory( nullptr ),
 	m_commands( {
 		{ QStringLiteral("autoconfigurebasedn"), tr( "Auto-configure the base DN via naming context" ) },
+		{ QStringLiteral("cachestatistics"), tr( "Look up users and computers and show statistics of the local query cache" ) },
 		{ QStringLiteral("query"), tr( "Query objects from LDAP directory" ) },
 		{ QStringLiteral("testbind"), tr( "Test binding to an LDAP server" ) },
+		{ QStringLiteral("testasyncquery"), tr( "Test querying the base DN asynchronously" ) },
 		{ QStringLiteral("help"), tr( "Show help about command" ) }
 	} )
 {
@@ -257,6 +260,8 @@ ConfigurationPage* LdapPlugin::createNetworkObjectDirectoryConfigurationPage()
 
 void LdapPlugin::reloadConfiguration()
 {
+	LdapQueryCache::instance().clear();
+
 	delete m_ldapDirectory;
 	m_ldapDirectory = new LdapDirectory( m_configuration );
 }
@@ -348,6 +353,62 @@ CommandLinePluginInterface::RunResult LdapPlugin::handle_autoconfigurebasedn( co
 
 
 
+CommandLinePluginInterface::RunResult LdapPlugin::handle_cachestatistics( const QStringList& arguments )
+{
+	for( const auto& argument : arguments )
+	{
+		const auto type = argument.section( QLatin1Char(':'), 0, 0 );
+		const auto name = argument.section( QLatin1Char(':'), 1 );
+
+		if( type == QLatin1String("user") )
+		{
+			const auto userDn = ldapDirectory().users( VeyonCore::stripDomain( name ) ).value( 0 );
+			if( userDn.isEmpty() == false )
+			{
+				ldapDirectory().groupsOfUser( userDn );
+			}
+		}
+		else if( type == QLatin1String("computer") )
+		{
+			const auto computerDn = ldapDirectory().computerObjectFromHost( name );
+			if( computerDn.isEmpty() == false )
+			{
+				ldapDirectory().groupsOfComputer( computerDn );
+				ldapDirectory().locationsOfComputer( computerDn );
+			}
+		}
+		else
+		{
+			return InvalidArguments;
+		}
+	}
+
+	const auto& cache = LdapQueryCache::instance();
+
+	CommandLineIO::TableHeader tableHeader( { tr("Query type"), tr("Entries"), tr("Hits"), tr("Negative hits"),
+											  tr("Misses"), tr("Deduplicated"), tr("Expired") } );
+	CommandLineIO::TableRows tableRows;
+
+	for( int i = 0; i < int(LdapQueryCache::QueryType::Count); ++i )
+	{
+		const auto type = LdapQueryCache::QueryType(i);
+		const auto statistics = cache.statistics( type );
+		tableRows.append( { LdapQueryCache::queryTypeName( type ),
+							QString::number( statistics.entries ),
+							QString::number( statistics.hits ),
+							QString::number( statistics.negativeHits ),
+							QString::number( statistics.misses ),
+							QString::number( statistics.deduplicatedQueries ),
+							QString::number( statistics.expiredEntries ) } );
+	}
+
+	CommandLineIO::printTable( CommandLineIO::Table( tableHeader, tableRows ) );
+
+	return Successful;
+}
+
+
+
 CommandLinePluginInterface::RunResult LdapPlugin::handle_query( const QStringList& arguments )
 {
 	QString objectType = arguments.value( 0 );
@@ -403,6 +464,23 @@ CommandLinePluginInterface::RunResult LdapPlugin::handle_testbind( const QString
 
 
 
+CommandLinePluginInterface::RunResult LdapPlugin::handle_testasyncquery( const QStringList& arguments )
+{
+	Q_UNUSED(arguments)
+
+	const auto result = LdapConfigurationTest( m_configuration ).testAsyncQuery();
+	if( result )
+	{
+		CommandLineIO::info( result.message );
+		return Successful;
+	}
+
+	CommandLineIO::error( result.message );
+	return Failed;
+}
+
+
+
 CommandLinePluginInterface::RunResult LdapPlugin::handle_help( const QStringList& arguments )
 {
 	QString command = arguments.value( 0 );
@@ -417,6 +495,17 @@ CommandLinePluginInterface::RunResult LdapPlugin::handle_help( const QStringList
 		return NoResult;
 	}
 
+	if( command == QLatin1String("testasyncquery") )
+	{
+		printf( "\n"
+				"ldap testasyncquery\n"
+				"\n"
+				"Query the configured base DN asynchronously like the LDAP network object\n"
+				"directory does and print the received entries.\n"
+				"\n\n" );
+		return NoResult;
+	}
+
 	if( command == QLatin1String("autoconfigurebasedn") )
 	{
 		printf( "\n"
@@ -430,6 +519,22 @@ CommandLinePluginInterface::RunResult LdapPlugin::handle_help( const QStringList
 		return NoResult;
 	}
 
+	if( command == QLatin1String("cachestatistics") )
+	{
+		printf( "\n"
+				"ldap cachestatistics [user:<user name>|computer:<host name> ...]\n"
+				"\n"
+				"Look up the given users and computers like access control does and print\n"
+				"statistics of the LDAP query cache afterwards. Specifying an object more than\n"
+				"once shows the effect of the cache.\n"
+				"\n"
+				"The cache is maintained per process so only the statistics of the lookups\n"
+				"made by this command are shown. Processes such as the Veyon Service write\n"
+				"their cache statistics to their log file every 10 minutes instead.\n"
+				"\n" );
+		return NoResult;
+	}
+
 	if( command == QLatin1String("query") )
 	{
 		printf( "\n"
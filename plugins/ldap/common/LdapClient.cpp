@@ -2,16 +2,35 @@
 // This file is part of Veyon - https://veyon.io
 // SPDX-License-Identifier: LGPL-2.0-or-later
 
+#include <QElapsedTimer>
+#include <QTimer>
+
 #include "LdapConfiguration.h"
 #include "LdapClient.h"
 
 #include <ldap.h>
 
 #include "ldapconnection.h"
+#include "ldapcontrol.h"
 #include "ldapoperation.h"
 #include "ldapserver.h"
 
 
+struct LdapClient::AsyncQuery
+{
+	KLDAPCore::LdapOperation operation;
+	QString dn;
+	QStringList attributes;
+	QStringList realAttributeNames;
+	QString filter;
+	Scope scope;
+	QByteArray cookie;
+	int id = -1;
+	bool isFirstResult = true;
+	QElapsedTimer lastActivityTimer;
+};
+
+
 static inline KLDAPCore::LdapUrl::Scope kldapUrlScope(LdapClient::Scope scope)
 {
 	switch (scope)
@@ -26,14 +45,77 @@ static inline KLDAPCore::LdapUrl::Scope kldapUrlScope(LdapClient::Scope scope)
 
 
 
+// extracts the cookie of the paged results control returned with the last result
+// of an operation - returns false if there are no more pages to fetch
+static bool nextPageCookie( const KLDAPCore::LdapOperation& operation, QByteArray& cookie )
+{
+	const auto controls = operation.controls();
+	for( const auto& control : controls )
+	{
+		if( control.oid() == QLatin1String(LDAP_CONTROL_PAGEDRESULTS) )
+		{
+			control.parsePageControl( cookie );
+			return cookie.isEmpty() == false;
+		}
+	}
+
+	cookie.clear();
+
+	return false;
+}
+
+
+
+static void addObject( const KLDAPCore::LdapObject& object, QStringList& attributeNames, bool& isFirstResult,
+					   LdapClient::Objects& objects )
+{
+	if( isFirstResult )
+	{
+		isFirstResult = false;
+
+		// match attribute name from result with requested attribute name in order
+		// to keep result aggregation below case-insensitive
+		const auto attributes = object.attributes();
+		for( auto it = attributes.constBegin(), end = attributes.constEnd(); it != end; ++it )
+		{
+			for( auto& attribute : attributeNames )
+			{
+				if( QString::compare( it.key().toLower(), attribute, Qt::CaseInsensitive ) == 0 )
+				{
+					attribute = it.key();
+					break;
+				}
+			}
+		}
+	}
+
+	// convert result list from type QList<QByteArray> to QStringList
+	const auto dn = object.dn().toString();
+	for( const auto& attribute : std::as_const(attributeNames) )
+	{
+		const auto values = object.values( attribute );
+		for( const auto& value : values )
+		{
+			objects[dn][attribute] += QString::fromUtf8( value );
+		}
+	}
+}
+
+
+
 LdapClient::LdapClient( const LdapConfiguration& configuration, const QUrl& url, QObject* parent ) :
 	QObject( parent ),
 	m_configuration( configuration ),
 	m_server( new KLDAPCore::LdapServer ),
 	m_connection( new KLDAPCore::LdapConnection ),
 	m_operation( new KLDAPCore::LdapOperation ),
-	m_queryTimeout(m_configuration.queryTimeout())
+	m_queryTimeout(m_configuration.queryTimeout()),
+	m_queryPageSize(m_configuration.queryPageSize()),
+	m_asyncQueryTimer(new QTimer(this))
 {
+	m_asyncQueryTimer->setInterval(AsyncQueryPollInterval);
+	connect(m_asyncQueryTimer, &QTimer::timeout, this, &LdapClient::processAsyncQueries);
+
 	connectAndBind( url );
 }
 
@@ -41,6 +123,8 @@ LdapClient::LdapClient( const LdapConfiguration& configuration, const QUrl& url,
 
 LdapClient::~LdapClient()
 {
+	qDeleteAll(m_asyncQueries);
+
 	delete m_connection;
 	delete m_operation;
 	delete m_server;
@@ -81,6 +165,7 @@ LdapClient::Objects LdapClient::queryObjects( const QString& dn, const QStringLi
 	if( m_state != Bound && reconnect() == false )
 	{
 		vCritical() << "not bound to server!";
+		++m_failedQueryCount;
 		return {};
 	}
 
@@ -98,55 +183,19 @@ LdapClient::Objects LdapClient::queryObjects( const QString& dn, const QStringLi
 
 	Objects entries;
 
-	int result = -1;
-	auto id = m_operation->search(KLDAPCore::LdapDN(dn), kldapUrlScope(scope), filter, attributes);
-
-	if( id != -1 )
+	auto realAttributeNames = attributes;
+	for( auto& attribute : realAttributeNames )
 	{
-		auto realAttributeNames = attributes;
-		for( auto& attribute : realAttributeNames )
-		{
-			attribute = attribute.toLower();
-		}
+		attribute = attribute.toLower();
+	}
 
-		auto isFirstResult = true;
+	auto isFirstResult = true;
 
-		while ((result = m_operation->waitForResult(id, m_queryTimeout)) == KLDAPCore::LdapOperation::RES_SEARCH_ENTRY)
-		{
-			if( isFirstResult )
-			{
-				isFirstResult = false;
+	const auto result = search( dn, attributes, filter, scope, [&]( const KLDAPCore::LdapObject& object ) {
+		addObject( object, realAttributeNames, isFirstResult, entries );
+	} );
 
-				// match attribute name from result with requested attribute name in order
-				// to keep result aggregation below case-insensitive
-				const auto attributes = m_operation->object().attributes();
-				for( auto it = attributes.constBegin(), end = attributes.constEnd(); it != end; ++it )
-				{
-					for( auto& attribute : realAttributeNames )
-					{
-						if( QString::compare( it.key().toLower(), attribute, Qt::CaseInsensitive ) == 0 )
-						{
-							attribute = it.key();
-							break;
-						}
-					}
-				}
-			}
-
-			// convert result list from type QList<QByteArray> to QStringList
-			const auto dn = m_operation->object().dn().toString();
-			for( const auto& attribute : realAttributeNames )
-			{
-				const auto values = m_operation->object().values( attribute );
-				for( const auto& value : values )
-				{
-					entries[dn][attribute] += QString::fromUtf8( value );
-				}
-			}
-		}
-
-		vDebug() << "results:" << entries;
-	}
+	vDebug() << "results:" << entries;
 
 	if( result == -1 )
 	{
@@ -160,6 +209,10 @@ LdapClient::Objects LdapClient::queryObjects( const QString& dn, const QStringLi
 			entries = queryObjects( dn, attributes, filter, scope );
 			m_queryRetry = false;
 		}
+		else
+		{
+			++m_failedQueryCount;
+		}
 	}
 
 	return entries;
@@ -168,6 +221,77 @@ LdapClient::Objects LdapClient::queryObjects( const QString& dn, const QStringLi
 
 
 
+LdapClient::QueryId LdapClient::queryObjectsAsync( const QString& dn, const QStringList& attributes,
+												   const QString& filter, Scope scope )
+{
+	vDebug() << "called with" << dn << attributes << filter << scope;
+
+	if( m_state != Bound && reconnect() == false )
+	{
+		vCritical() << "not bound to server!";
+		return InvalidQueryId;
+	}
+
+	if( dn.isEmpty() )
+	{
+		vCritical() << "DN is empty!";
+		return InvalidQueryId;
+	}
+
+	if( attributes.isEmpty() )
+	{
+		vCritical() << "attributes empty!";
+		return InvalidQueryId;
+	}
+
+	auto query = new AsyncQuery;
+	query->dn = dn;
+	query->attributes = attributes;
+	query->filter = filter;
+	query->scope = scope;
+	for( const auto& attribute : attributes )
+	{
+		query->realAttributeNames.append( attribute.toLower() );
+	}
+	query->operation.setConnection( *m_connection );
+	query->id = startSearch( query->operation, dn, attributes, filter, scope, {} );
+
+	if( query->id == -1 )
+	{
+		vWarning() << "LDAP search failed with code" << m_connection->ldapErrorCode();
+		delete query;
+		return InvalidQueryId;
+	}
+
+	query->lastActivityTimer.start();
+
+	const auto queryId = ++m_lastQueryId;
+	m_asyncQueries[queryId] = query;
+
+	m_asyncQueryTimer->start();
+
+	return queryId;
+}
+
+
+
+void LdapClient::cancelQuery( QueryId queryId )
+{
+	auto query = m_asyncQueries.take( queryId );
+	if( query )
+	{
+		query->operation.abandon( query->id );
+		delete query;
+	}
+
+	if( m_asyncQueries.isEmpty() )
+	{
+		m_asyncQueryTimer->stop();
+	}
+}
+
+
+
 QStringList LdapClient::queryAttributeValues( const QString& dn, const QString& attribute,
 											  const QString& filter, Scope scope )
 {
@@ -176,6 +300,7 @@ QStringList LdapClient::queryAttributeValues( const QString& dn, const QString&
 	if( m_state != Bound && reconnect() == false )
 	{
 		vCritical() << "not bound to server!";
+		++m_failedQueryCount;
 		return {};
 	}
 
@@ -194,43 +319,36 @@ QStringList LdapClient::queryAttributeValues( const QString& dn, const QString&
 
 	QStringList entries;
 
-	int result = -1;
-	int id = m_operation->search(KLDAPCore::LdapDN(dn), kldapUrlScope(scope), filter, QStringList(attribute));
+	bool isFirstResult = true;
+	QString realAttributeName = attribute.toLower();
 
-	if( id != -1 )
-	{
-		bool isFirstResult = true;
-		QString realAttributeName = attribute.toLower();
-
-		while ((result = m_operation->waitForResult(id, m_queryTimeout)) == KLDAPCore::LdapOperation::RES_SEARCH_ENTRY)
+	const auto result = search( dn, QStringList(attribute), filter, scope, [&]( const KLDAPCore::LdapObject& object ) {
+		if( isFirstResult )
 		{
-			if( isFirstResult )
-			{
-				isFirstResult = false;
+			isFirstResult = false;
 
-				// match attribute name from result with requested attribute name in order
-				// to keep result aggregation below case-insensitive
-				const auto attributes = m_operation->object().attributes();
-				for( auto it = attributes.constBegin(), end = attributes.constEnd(); it != end; ++it )
+			// match attribute name from result with requested attribute name in order
+			// to keep result aggregation below case-insensitive
+			const auto attributes = object.attributes();
+			for( auto it = attributes.constBegin(), end = attributes.constEnd(); it != end; ++it )
+			{
+				if( it.key().toLower() == realAttributeName )
 				{
-					if( it.key().toLower() == realAttributeName )
-					{
-						realAttributeName = it.key();
-						break;
-					}
+					realAttributeName = it.key();
+					break;
 				}
 			}
+		}
 
-			// convert result list from type QList<QByteArray> to QStringList
-			const auto values = m_operation->object().values( realAttributeName );
-			for( const auto& value : values )
-			{
-				entries += QString::fromUtf8( value );
-			}
+		// convert result list from type QList<QByteArray> to QStringList
+		const auto values = object.values( realAttributeName );
+		for( const auto& value : values )
+		{
+			entries += QString::fromUtf8( value );
 		}
+	} );
 
-		vDebug() << "results:" << entries;
-	}
+	vDebug() << "results:" << entries;
 
 	if( result == -1 )
 	{
@@ -244,6 +362,10 @@ QStringList LdapClient::queryAttributeValues( const QString& dn, const QString&
 			entries = queryAttributeValues( dn, attribute, filter, scope );
 			m_queryRetry = false;
 		}
+		else
+		{
+			++m_failedQueryCount;
+		}
 	}
 
 	return entries;
@@ -258,6 +380,7 @@ QStringList LdapClient::queryDistinguishedNames( const QString& dn, const QStrin
 	if( m_state != Bound && reconnect() == false )
 	{
 		vCritical() << "not bound to server!";
+		++m_failedQueryCount;
 		return {};
 	}
 
@@ -269,17 +392,11 @@ QStringList LdapClient::queryDistinguishedNames( const QString& dn, const QStrin
 
 	QStringList distinguishedNames;
 
-	int result = -1;
-	int id = m_operation->search( KLDAPCore::LdapDN(dn), kldapUrlScope(scope), filter, QStringList() );
+	const auto result = search( dn, {}, filter, scope, [&]( const KLDAPCore::LdapObject& object ) {
+		distinguishedNames += object.dn().toString();
+	} );
 
-	if( id != -1 )
-	{
-		while ((result = m_operation->waitForResult(id, m_queryTimeout)) == KLDAPCore::LdapOperation::RES_SEARCH_ENTRY)
-		{
-			distinguishedNames += m_operation->object().dn().toString();
-		}
-		vDebug() << "results" << distinguishedNames;
-	}
+	vDebug() << "results" << distinguishedNames;
 
 	if( result == -1 )
 	{
@@ -293,6 +410,10 @@ QStringList LdapClient::queryDistinguishedNames( const QString& dn, const QStrin
 			distinguishedNames = queryDistinguishedNames( dn, filter, scope );
 			m_queryRetry = false;
 		}
+		else
+		{
+			++m_failedQueryCount;
+		}
 	}
 
 	return distinguishedNames;
@@ -300,6 +421,139 @@ QStringList LdapClient::queryDistinguishedNames( const QString& dn, const QStrin
 
 
 
+int LdapClient::search( const QString& dn, const QStringList& attributes, const QString& filter, Scope scope,
+						const EntryHandler& handleEntry )
+{
+	QByteArray cookie;
+	int result = -1;
+
+	// fetch all pages of a paged search so servers with page size limits do not truncate results
+	do
+	{
+		const auto id = startSearch( *m_operation, dn, attributes, filter, scope, cookie );
+		if( id == -1 )
+		{
+			return -1;
+		}
+
+		while ((result = m_operation->waitForResult(id, m_queryTimeout)) == KLDAPCore::LdapOperation::RES_SEARCH_ENTRY)
+		{
+			handleEntry( m_operation->object() );
+		}
+	}
+	while( result == KLDAPCore::LdapOperation::RES_SEARCH_RESULT && nextPageCookie( *m_operation, cookie ) );
+
+	return result;
+}
+
+
+
+int LdapClient::startSearch( KLDAPCore::LdapOperation& operation, const QString& dn, const QStringList& attributes,
+							 const QString& filter, Scope scope, const QByteArray& cookie ) const
+{
+	// paging is pointless for base object searches, e.g. when querying the root DSE
+	KLDAPCore::LdapControls serverControls;
+	if( m_queryPageSize > 0 && scope != Scope::Base )
+	{
+		KLDAPCore::LdapControl::insert( serverControls, KLDAPCore::LdapControl::createPageControl( m_queryPageSize, cookie ) );
+	}
+
+	operation.setServerControls( serverControls );
+
+	return operation.search( KLDAPCore::LdapDN(dn), kldapUrlScope(scope), filter, attributes );
+}
+
+
+
+void LdapClient::processAsyncQueries()
+{
+	const auto queryIds = m_asyncQueries.keys();
+
+	for( const auto queryId : queryIds )
+	{
+		auto query = m_asyncQueries.value( queryId );
+		if( query == nullptr )
+		{
+			// cancelled while handling results of another query
+			continue;
+		}
+
+		Objects objects;
+		int result = 0;
+		int entryCount = 0;
+
+		// only fetch results which already have arrived so that the event loop never blocks
+		// no matter how many queries are pending
+		while( entryCount < AsyncQueryMaximumEntriesPerPoll &&
+			   (result = query->operation.waitForResult(query->id, AsyncQueryPollTimeout)) == KLDAPCore::LdapOperation::RES_SEARCH_ENTRY )
+		{
+			addObject( query->operation.object(), query->realAttributeNames, query->isFirstResult, objects );
+			++entryCount;
+		}
+
+		auto finished = false;
+		auto success = false;
+
+		if( result == KLDAPCore::LdapOperation::RES_SEARCH_RESULT )
+		{
+			if( nextPageCookie( query->operation, query->cookie ) )
+			{
+				query->id = startSearch( query->operation, query->dn, query->attributes, query->filter, query->scope, query->cookie );
+				finished = query->id == -1;
+			}
+			else
+			{
+				finished = true;
+				success = true;
+			}
+		}
+		else if( result == -1 ||
+				 ( result == 0 && entryCount == 0 && query->lastActivityTimer.hasExpired( m_queryTimeout ) ) )
+		{
+			vWarning() << "LDAP search failed with code" << m_connection->ldapErrorCode();
+			finished = true;
+		}
+
+		if( result != 0 || entryCount > 0 )
+		{
+			query->lastActivityTimer.restart();
+		}
+
+		if( objects.isEmpty() == false )
+		{
+			Q_EMIT objectsReceived( queryId, objects );
+		}
+
+		if( finished && m_asyncQueries.contains( queryId ) )
+		{
+			delete m_asyncQueries.take( queryId );
+			Q_EMIT queryFinished( queryId, success );
+		}
+	}
+
+	if( m_asyncQueries.isEmpty() )
+	{
+		m_asyncQueryTimer->stop();
+	}
+}
+
+
+
+void LdapClient::abortAsyncQueries()
+{
+	const auto queryIds = m_asyncQueries.keys();
+
+	for( const auto queryId : queryIds )
+	{
+		delete m_asyncQueries.take( queryId );
+		Q_EMIT queryFinished( queryId, false );
+	}
+
+	m_asyncQueryTimer->stop();
+}
+
+
+
 QStringList LdapClient::queryObjectAttributes( const QString& dn )
 {
 	vDebug() << "called with" << dn;
@@ -519,6 +773,9 @@ void LdapClient::initTLS()
 
 bool LdapClient::reconnect()
 {
+	// pending asynchronous searches can't be continued on a new connection
+	abortAsyncQueries();
+
 	m_connection->close();
 	m_state = Disconnected;
 
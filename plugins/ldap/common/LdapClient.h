@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <functional>
+
+#include <QHash>
 #include <QObject>
 #include <QUrl>
 
@@ -12,6 +15,7 @@
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
 namespace KLDAP {
 class LdapConnection;
+class LdapObject;
 class LdapOperation;
 class LdapServer;
 }
@@ -19,11 +23,14 @@ namespace KLDAPCore = KLDAP;
 #else
 namespace KLDAPCore {
 class LdapConnection;
+class LdapObject;
 class LdapOperation;
 class LdapServer;
 }
 #endif
 
+class QTimer;
+
 class LdapConfiguration;
 
 class LDAP_COMMON_EXPORT LdapClient : public QObject
@@ -56,6 +63,9 @@ public:
 	Q_ENUM(TLSVerifyMode)
 
 	using Objects = QMap<QString, QMap<QString, QStringList> >;
+	using QueryId = int;
+
+	static constexpr QueryId InvalidQueryId = -1;
 
 	explicit LdapClient( const LdapConfiguration& configuration, const QUrl& url = QUrl(), QObject* parent = nullptr );
 	~LdapClient() override;
@@ -78,8 +88,19 @@ public:
 	QString errorString() const;
 	QString errorDescription() const;
 
+	// number of synchronous queries which failed (after retrying) - allows callers to tell
+	// empty results from failed queries
+	quint64 failedQueryCount() const
+	{
+		return m_failedQueryCount;
+	}
+
 	Objects queryObjects( const QString& dn, const QStringList& attributes, const QString& filter, Scope scope );
 
+	// runs a search without blocking and delivers each page of results via objectsReceived()
+	QueryId queryObjectsAsync( const QString& dn, const QStringList& attributes, const QString& filter, Scope scope );
+	void cancelQuery( QueryId queryId );
+
 	QStringList queryAttributeValues( const QString &dn, const QString &attribute,
 									  const QString& filter = QStringLiteral( "(objectclass=*)" ),
 									  Scope scope = Scope::Base );
@@ -116,9 +137,30 @@ public:
 	}
 
 	static constexpr int DefaultQueryTimeout = 3000;
+	static constexpr int DefaultQueryPageSize = 500;
+
+Q_SIGNALS:
+	void objectsReceived( LdapClient::QueryId queryId, const LdapClient::Objects& objects );
+	void queryFinished( LdapClient::QueryId queryId, bool success );
 
 private:
+	struct AsyncQuery;
+	using EntryHandler = std::function<void(const KLDAPCore::LdapObject&)>;
+
 	static constexpr auto LdapLibraryDebugAny = -1;
+	static constexpr auto AsyncQueryPollInterval = 20;
+	// LdapOperation::waitForResult() does not read any result at all for a zero timeout
+	// so wait for the minimum timeout possible
+	static constexpr auto AsyncQueryPollTimeout = 1;
+	static constexpr auto AsyncQueryMaximumEntriesPerPoll = 100;
+
+	int search( const QString& dn, const QStringList& attributes, const QString& filter, Scope scope,
+				const EntryHandler& handleEntry );
+	int startSearch( KLDAPCore::LdapOperation& operation, const QString& dn, const QStringList& attributes,
+					 const QString& filter, Scope scope, const QByteArray& cookie ) const;
+
+	void processAsyncQueries();
+	void abortAsyncQueries();
 
 	bool reconnect();
 	bool connectAndBind( const QUrl& url );
@@ -140,10 +182,16 @@ private:
 	State m_state = Disconnected;
 
 	bool m_queryRetry = false;
+	quint64 m_failedQueryCount{0};
 
 	QString m_baseDn;
 	QString m_namingContextAttribute;
 
 	const int m_queryTimeout{DefaultQueryTimeout};
+	const int m_queryPageSize{DefaultQueryPageSize};
+
+	QTimer* m_asyncQueryTimer{nullptr};
+	QHash<QueryId, AsyncQuery*> m_asyncQueries;
+	QueryId m_lastQueryId{0};
 
 };
@@ -21,6 +21,12 @@
 	OP( LdapConfiguration, m_configuration, Configuration::Password, bindPassword, setBindPassword, "BindPassword", "LDAP", QString(), Configuration::Property::Flag::Standard )	\
 	OP( LdapConfiguration, m_configuration, bool, queryNamingContext, setQueryNamingContext, "QueryNamingContext", "LDAP", false, Configuration::Property::Flag::Standard )	\
 	OP( LdapConfiguration, m_configuration, int, queryTimeout, setQueryTimeout, "QueryTimeout", "LDAP", LdapClient::DefaultQueryTimeout, Configuration::Property::Flag::Advanced )	\
+	OP( LdapConfiguration, m_configuration, int, queryPageSize, setQueryPageSize, "QueryPageSize", "LDAP", LdapClient::DefaultQueryPageSize, Configuration::Property::Flag::Advanced )	\
+	OP( LdapConfiguration, m_configuration, int, userCacheTimeout, setUserCacheTimeout, "UserCacheTimeout", "LDAP", 60, Configuration::Property::Flag::Hidden )	\
+	OP( LdapConfiguration, m_configuration, int, computerCacheTimeout, setComputerCacheTimeout, "ComputerCacheTimeout", "LDAP", 300, Configuration::Property::Flag::Hidden )	\
+	OP( LdapConfiguration, m_configuration, int, negativeCacheTimeout, setNegativeCacheTimeout, "NegativeCacheTimeout", "LDAP", 30, Configuration::Property::Flag::Hidden )	\
+	OP( LdapConfiguration, m_configuration, bool, incrementalDirectorySynchronization, setIncrementalDirectorySynchronization, "IncrementalDirectorySynchronization", "LDAP", true, Configuration::Property::Flag::Hidden )	\
+	OP( LdapConfiguration, m_configuration, int, fullDirectorySynchronizationInterval, setFullDirectorySynchronizationInterval, "FullDirectorySynchronizationInterval", "LDAP", 900, Configuration::Property::Flag::Hidden )	\
 	OP( LdapConfiguration, m_configuration, QString, baseDn, setBaseDn, "BaseDN", "LDAP", QString(), Configuration::Property::Flag::Standard )	\
 	OP( LdapConfiguration, m_configuration, QString, namingContextAttribute, setNamingContextAttribute, "NamingContextAttribute", "LDAP", QString(), Configuration::Property::Flag::Standard )	\
 	OP( LdapConfiguration, m_configuration, QString, userTree, setUserTree, "UserTree", "LDAP", QString(), Configuration::Property::Flag::Standard )	\
@@ -23,6 +23,7 @@ LdapConfigurationPage::LdapConfigurationPage( LdapConfiguration& configuration,
 	ui->setupUi(this);
 
 	Configuration::UiMapping::setFlags(ui->queryTimeoutLabel, Configuration::Property::Flag::Advanced);
+	Configuration::UiMapping::setFlags(ui->queryPageSizeLabel, Configuration::Property::Flag::Advanced);
 
 #define CONNECT_BUTTON_SLOT(name)	connect( ui->name, &QPushButton::clicked, this, &LdapConfigurationPage::name );
 
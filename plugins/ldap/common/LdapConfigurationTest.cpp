@@ -2,6 +2,9 @@
 // This file is part of Veyon - https://veyon.io
 // SPDX-License-Identifier: LGPL-2.0-or-later
 
+#include <QEventLoop>
+#include <QTimer>
+
 #include "LdapConfiguration.h"
 #include "LdapConfigurationTest.h"
 #include "LdapDirectory.h"
@@ -110,6 +113,64 @@ LdapConfigurationTest::Result LdapConfigurationTest::testNamingContext()
 
 
 
+LdapConfigurationTest::Result LdapConfigurationTest::testAsyncQuery()
+{
+	const auto bindTestResult = testBind();
+	if( bindTestResult )
+	{
+		vDebug() << "[TEST][LDAP] Testing asynchronous query";
+
+		LdapClient ldapClient( m_configuration );
+
+		LdapClient::Objects objects;
+		auto finished = false;
+		auto success = false;
+
+		QEventLoop eventLoop;
+		QObject::connect( &ldapClient, &LdapClient::objectsReceived, &eventLoop,
+						  [&]( LdapClient::QueryId, const LdapClient::Objects& receivedObjects ) {
+							  for( auto it = receivedObjects.constBegin(); it != receivedObjects.constEnd(); ++it )
+							  {
+								  objects[it.key()] = it.value();
+							  }
+						  } );
+		QObject::connect( &ldapClient, &LdapClient::queryFinished, &eventLoop,
+						  [&]( LdapClient::QueryId, bool querySuccess ) {
+							  finished = true;
+							  success = querySuccess;
+							  eventLoop.quit();
+						  } );
+
+		const auto queryId = ldapClient.queryObjectsAsync( ldapClient.baseDn(), { QStringLiteral("objectClass") },
+														   QStringLiteral( "(objectclass=*)" ), LdapClient::Scope::Base );
+		if( queryId != LdapClient::InvalidQueryId )
+		{
+			// the query times out on its own if no results arrive in time
+			QTimer::singleShot( m_configuration.queryTimeout() * 2, &eventLoop, &QEventLoop::quit );
+			eventLoop.exec();
+		}
+
+		if( finished == false || success == false || objects.isEmpty() )
+		{
+			return { false,
+					LdapConfiguration::tr( "LDAP asynchronous query test failed"),
+					LdapConfiguration::tr( "Could not query the configured base DN asynchronously. "
+										   "Please check the base DN and query timeout parameters.\n\n"
+										   "%1" ).arg( ldapClient.errorDescription() ) };
+		}
+
+		return { true,
+				LdapConfiguration::tr( "LDAP asynchronous query test successful" ),
+				LdapConfiguration::tr( "The LDAP base DN has been queried asynchronously. "
+									   "The following entries were received:\n\n%1" ).
+				arg( objects.keys().join(QLatin1Char('\n')) ) };
+	}
+
+	return bindTestResult;
+}
+
+
+
 LdapConfigurationTest::Result LdapConfigurationTest::testUserTree()
 {
 	const auto bindTestResult = testBind();
@@ -117,7 +178,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testUserTree()
 	{
 		vDebug() << "[TEST][LDAP] Testing user tree";
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 		ldapDirectory.disableAttributes();
 		ldapDirectory.disableFilters();
 		int count = ldapDirectory.users().count();
@@ -138,7 +199,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testGroupTree()
 	{
 		vDebug() << "[TEST][LDAP] Testing group tree";
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 		ldapDirectory.disableAttributes();
 		ldapDirectory.disableFilters();
 		const auto count = ldapDirectory.groups().count();
@@ -159,7 +220,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testComputerTree()
 	{
 		vDebug() << "[TEST][LDAP] Testing computer tree";
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 		ldapDirectory.disableAttributes();
 		ldapDirectory.disableFilters();
 		int count = ldapDirectory.computersByHostName().count();
@@ -181,7 +242,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testComputerGroupTree()
 	{
 		vDebug() << "[TEST][LDAP] Testing computer group tree";
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 		ldapDirectory.disableAttributes();
 		ldapDirectory.disableFilters();
 		int count = ldapDirectory.computerGroups().count();
@@ -202,7 +263,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testUserLoginNameAttribute(
 	{
 		vDebug() << "[TEST][LDAP] Testing user login attribute for" << userFilter;
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 		ldapDirectory.disableFilters();
 
 		return reportLdapObjectQueryResults( LdapConfiguration::tr( "user objects" ),
@@ -221,7 +282,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testGroupMemberAttribute( c
 	{
 		vDebug() << "[TEST][LDAP] Testing group member attribute for" << groupFilter;
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 		ldapDirectory.disableFilters();
 
 		QStringList groups = ldapDirectory.groups( groupFilter );
@@ -251,7 +312,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testComputerDisplayNameAttr
 	{
 		vDebug() << "[TEST][LDAP] Testing computer display name attribute";
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 		ldapDirectory.disableFilters();
 
 		return reportLdapObjectQueryResults( LdapConfiguration::tr( "computer objects" ),
@@ -290,7 +351,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testComputerHostNameAttribu
 
 		vDebug() << "[TEST][LDAP] Testing computer hostname attribute";
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 		ldapDirectory.disableFilters();
 
 		return reportLdapObjectQueryResults( LdapConfiguration::tr( "computer objects" ),
@@ -309,7 +370,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testComputerMacAddressAttri
 	{
 		vDebug() << "[TEST][LDAP] Testing computer MAC address attribute";
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 		ldapDirectory.disableFilters();
 
 		const auto  macAddress = ldapDirectory.computerMacAddress( computerDn );
@@ -331,7 +392,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testComputerLocationAttribu
 	{
 		vDebug() << "[TEST][LDAP] Testing computer location attribute for" << locationName;
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 
 		return reportLdapObjectQueryResults( LdapConfiguration::tr( "computer locations" ),
 											 { LdapConfiguration::tr( "Computer location attribute" ) },
@@ -349,7 +410,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testLocationNameAttribute(
 	{
 		vDebug() << "[TEST][LDAP] Testing location name attribute for" << locationName;
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 
 		return reportLdapObjectQueryResults( LdapConfiguration::tr( "computer locations" ),
 											 { LdapConfiguration::tr( "Location name attribute" ) },
@@ -365,7 +426,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testUsersFilter()
 {
 	vDebug() << "[TEST][LDAP] Testing users filter";
 
-	LdapDirectory ldapDirectory( m_configuration );
+	LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 	const auto count = ldapDirectory.users().count();
 
 	return reportLdapFilterTestResult( LdapConfiguration::tr( "users" ), count, ldapDirectory.client().errorDescription() );
@@ -377,7 +438,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testUserGroupsFilter()
 {
 	vDebug() << "[TEST][LDAP] Testing user groups filter";
 
-	LdapDirectory ldapDirectory( m_configuration );
+	LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 	const auto count = ldapDirectory.userGroups().count();
 
 	return reportLdapFilterTestResult( LdapConfiguration::tr( "user groups" ), count, ldapDirectory.client().errorDescription() );
@@ -389,7 +450,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testComputersFilter()
 {
 	vDebug() << "[TEST][LDAP] Testing computers filter";
 
-	LdapDirectory ldapDirectory( m_configuration );
+	LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 	const auto count = ldapDirectory.computersByHostName().count();
 
 	return reportLdapFilterTestResult( LdapConfiguration::tr( "computers" ), count, ldapDirectory.client().errorDescription() );
@@ -401,7 +462,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testComputerGroupsFilter()
 {
 	vDebug() << "[TEST][LDAP] Testing computer groups filter";
 
-	LdapDirectory ldapDirectory( m_configuration );
+	LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 	const auto count = ldapDirectory.computerGroups().count();
 
 	return reportLdapFilterTestResult( LdapConfiguration::tr( "computer groups" ), count, ldapDirectory.client().errorDescription() );
@@ -413,7 +474,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testComputerContainersFilte
 {
 	vDebug() << "[TEST][LDAP] Testing computer containers filter";
 
-	LdapDirectory ldapDirectory( m_configuration );
+	LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 	const auto count = ldapDirectory.computerLocations().count();
 
 	return reportLdapFilterTestResult( LdapConfiguration::tr( "computer containers" ), count, ldapDirectory.client().errorDescription() );
@@ -427,7 +488,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testGroupsOfUser( const QSt
 	{
 		vDebug() << "[TEST][LDAP] Testing groups of user" << username;
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 
 		const auto userObjects = ldapDirectory.users(username);
 
@@ -456,7 +517,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testGroupsOfComputer( const
 	{
 		vDebug() << "[TEST][LDAP] Testing groups of computer for" << computerHostName;
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 
 		QStringList computerObjects = ldapDirectory.computersByHostName(computerHostName);
 
@@ -486,7 +547,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testComputerObjectByIpAddre
 	{
 		vDebug() << "[TEST][LDAP] Testing computer object resolve by IP address" << computerIpAddress;
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 
 		QString computerName = ldapDirectory.hostToLdapFormat( computerIpAddress );
 
@@ -516,7 +577,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testLocationEntries( const
 	{
 		vDebug() << "[TEST][LDAP] Testing location entries for" << locationName;
 
-		LdapDirectory ldapDirectory( m_configuration );
+		LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 		return reportLdapObjectQueryResults( LdapConfiguration::tr( "location entries" ),
 											 { LdapConfiguration::tr( "Computer groups filter" ),
 											  LdapConfiguration::tr( "Computer locations identification") },
@@ -533,7 +594,7 @@ LdapConfigurationTest::Result LdapConfigurationTest::testLocations()
 {
 	vDebug() << "[TEST][LDAP] Querying all locations";
 
-	LdapDirectory ldapDirectory( m_configuration );
+	LdapDirectory ldapDirectory( m_configuration, LdapDirectory::CacheMode::Disabled );
 	return reportLdapObjectQueryResults( LdapConfiguration::tr( "location entries" ),
 										 { LdapConfiguration::tr( "Filter for computer groups" ),
 										  LdapConfiguration::tr( "Computer locations identification") },
@@ -31,6 +31,7 @@ public:
 	Result testBind();
 	Result testBaseDn();
 	Result testNamingContext();
+	Result testAsyncQuery();
 	Result testUserTree();
 	Result testGroupTree();
 	Result testComputerTree();
@@ -8,6 +8,13 @@
 
 
 LdapDirectory::LdapDirectory( const LdapConfiguration& configuration, QObject* parent ) :
+	LdapDirectory( configuration, CacheMode::Enabled, parent )
+{
+}
+
+
+
+LdapDirectory::LdapDirectory( const LdapConfiguration& configuration, CacheMode cacheMode, QObject* parent ) :
 	QObject( parent ),
 	m_configuration( configuration ),
 	m_client( configuration, QUrl(), this )
@@ -60,6 +67,13 @@ LdapDirectory::LdapDirectory( const LdapConfiguration& configuration, QObject* p
 	m_computerLocationAttribute = m_configuration.computerLocationAttribute();
 
 	m_mapContainerStructureToLocations = m_configuration.mapContainerStructureToLocations();
+
+	if( cacheMode == CacheMode::Enabled )
+	{
+		m_userCacheTimeout = m_configuration.userCacheTimeout();
+		m_computerCacheTimeout = m_configuration.computerCacheTimeout();
+		m_negativeCacheTimeout = m_configuration.negativeCacheTimeout();
+	}
 }
 
 
@@ -158,9 +172,19 @@ void LdapDirectory::disableFilters()
 
 QStringList LdapDirectory::users( const QString& filterValue )
 {
-	return m_client.queryDistinguishedNames( usersDn(),
-											 LdapClient::constructQueryFilter( m_userLoginNameAttribute, filterValue, m_usersFilter ),
-											 m_defaultSearchScope );
+	const auto query = [=]() {
+		return m_client.queryDistinguishedNames( usersDn(),
+												 LdapClient::constructQueryFilter( m_userLoginNameAttribute, filterValue, m_usersFilter ),
+												 m_defaultSearchScope );
+	};
+
+	// only cache lookups of individual users
+	if( filterValue.isEmpty() || filterValue.contains( QLatin1Char('*') ) )
+	{
+		return query();
+	}
+
+	return cachedLookup( LdapQueryCache::QueryType::Users, filterValue, query );
 }
 
 
@@ -199,9 +223,19 @@ QStringList LdapDirectory::computersByDisplayName( const QString& filterValue )
  */
 QStringList LdapDirectory::computersByHostName( const QString& filterValue )
 {
-	return m_client.queryDistinguishedNames( computersDn(),
-											 LdapClient::constructQueryFilter( m_computerHostNameAttribute, filterValue, m_computersFilter ),
-											 computerSearchScope() );
+	const auto query = [=]() {
+		return m_client.queryDistinguishedNames( computersDn(),
+												 LdapClient::constructQueryFilter( m_computerHostNameAttribute, filterValue, m_computersFilter ),
+												 computerSearchScope() );
+	};
+
+	// only cache lookups of individual computers
+	if( filterValue.isEmpty() || filterValue.contains( QLatin1Char('*') ) )
+	{
+		return query();
+	}
+
+	return cachedLookup( LdapQueryCache::QueryType::Computers, filterValue, query );
 }
 
 
@@ -265,9 +299,11 @@ QStringList LdapDirectory::groupsOfUser( const QString& userDn )
 		return {};
 	}
 
-	return m_client.queryDistinguishedNames( groupsDn(),
-											 LdapClient::constructQueryFilter( m_groupMemberFilterAttribute, userId, m_userGroupsFilter ),
-											 m_defaultSearchScope );
+	return cachedLookup( LdapQueryCache::QueryType::UserGroups, userId, [=]() {
+		return m_client.queryDistinguishedNames( groupsDn(),
+												 LdapClient::constructQueryFilter( m_groupMemberFilterAttribute, userId, m_userGroupsFilter ),
+												 m_defaultSearchScope );
+	} );
 }
 
 
@@ -280,14 +316,25 @@ QStringList LdapDirectory::groupsOfComputer( const QString& computerDn )
 		return {};
 	}
 
-	return m_client.queryDistinguishedNames( computerGroupsDn(),
-											 LdapClient::constructQueryFilter( m_groupMemberFilterAttribute, computerId, m_computerGroupsFilter ),
-											 m_defaultSearchScope );
+	return cachedLookup( LdapQueryCache::QueryType::ComputerGroups, computerId, [=]() {
+		return m_client.queryDistinguishedNames( computerGroupsDn(),
+												 LdapClient::constructQueryFilter( m_groupMemberFilterAttribute, computerId, m_computerGroupsFilter ),
+												 m_defaultSearchScope );
+	} );
 }
 
 
 
 QStringList LdapDirectory::locationsOfComputer( const QString& computerDn )
+{
+	return cachedLookup( LdapQueryCache::QueryType::ComputerLocations, computerDn, [=]() {
+		return queryLocationsOfComputer( computerDn );
+	} );
+}
+
+
+
+QStringList LdapDirectory::queryLocationsOfComputer( const QString& computerDn )
 {
 	if( m_computerLocationsByAttribute )
 	{
@@ -461,6 +508,23 @@ QString LdapDirectory::computerObjectFromHost( const QString& host )
 
 
 
+QStringList LdapDirectory::cachedLookup( LdapQueryCache::QueryType type, const QString& key,
+										 const std::function<QStringList()>& query )
+{
+	const auto timeout = ( type == LdapQueryCache::QueryType::Users || type == LdapQueryCache::QueryType::UserGroups )
+							 ? m_userCacheTimeout : m_computerCacheTimeout;
+
+	return LdapQueryCache::instance().lookup( configInstanceId(), type, key, timeout, m_negativeCacheTimeout,
+											  [this, &query]( bool& success ) {
+		const auto failedQueryCount = m_client.failedQueryCount();
+		const auto values = query();
+		success = m_client.failedQueryCount() == failedQueryCount;
+		return values;
+	} );
+}
+
+
+
 LdapClient::Scope LdapDirectory::computerSearchScope() const
 {
 	// when using containers/OUs as locations computer objects are not located directly below the configured computer DN
@@ -6,6 +6,7 @@
 
 #include "LdapClient.h"
 #include "LdapCommon.h"
+#include "LdapQueryCache.h"
 #include "VeyonCore.h"
 
 class LdapConfiguration;
@@ -15,7 +16,13 @@ class LDAP_COMMON_EXPORT LdapDirectory : public QObject
 {
 	Q_OBJECT
 public:
+	enum class CacheMode {
+		Enabled,
+		Disabled // e.g. for tests which always have to reflect the current configuration
+	};
+
 	explicit LdapDirectory( const LdapConfiguration& configuration, QObject* parent = nullptr );
+	LdapDirectory( const LdapConfiguration& configuration, CacheMode cacheMode, QObject* parent = nullptr );
 	~LdapDirectory() override = default;
 
 	const QString& configInstanceId() const;
@@ -105,6 +112,9 @@ public:
 private:
 	LdapClient::Scope computerSearchScope() const;
 
+	QStringList queryLocationsOfComputer( const QString& computerDn );
+	QStringList cachedLookup( LdapQueryCache::QueryType type, const QString& key, const std::function<QStringList()>& query );
+
 	const LdapConfiguration& m_configuration;
 	LdapClient m_client;
 
@@ -138,4 +148,8 @@ private:
 
 	bool m_mapContainerStructureToLocations = false;
 
+	int m_userCacheTimeout = 0;
+	int m_computerCacheTimeout = 0;
+	int m_negativeCacheTimeout = 0;
+
 };
@@ -7,11 +7,55 @@
 #include "LdapNetworkObjectDirectory.h"
 
 
+static QString modifyTimestampAttribute()
+{
+	return QStringLiteral("modifyTimestamp");
+}
+
+
+
+static QStringList attributeValues(const QMap<QString, QStringList>& attributes, const QString& attribute)
+{
+	// attribute names in results follow the spelling of the server
+	for (auto it = attributes.constBegin(), end = attributes.constEnd(); it != end; ++it)
+	{
+		if (QString::compare(it.key(), attribute, Qt::CaseInsensitive) == 0)
+		{
+			return it.value();
+		}
+	}
+
+	return {};
+}
+
+
+
+static void updateTimestamp(const LdapClient::Objects& objects, QString& timestamp)
+{
+	// generalized time values of the same server can be compared as strings
+	for (auto it = objects.constBegin(), end = objects.constEnd(); it != end; ++it)
+	{
+		const auto objectTimestamp = attributeValues(it.value(), modifyTimestampAttribute()).value(0);
+		if (objectTimestamp > timestamp)
+		{
+			timestamp = objectTimestamp;
+		}
+	}
+}
+
+
+
 LdapNetworkObjectDirectory::LdapNetworkObjectDirectory(const LdapConfiguration& ldapConfiguration,
 													   QObject* parent) :
 	NetworkObjectDirectory(ldapConfiguration.directoryName(), parent),
-	m_ldapDirectory(ldapConfiguration)
+	m_ldapDirectory(ldapConfiguration),
+	m_incrementalSynchronization(ldapConfiguration.incrementalDirectorySynchronization()),
+	m_fullSynchronizationInterval(ldapConfiguration.fullDirectorySynchronizationInterval())
 {
+	connect(&m_ldapDirectory.client(), &LdapClient::objectsReceived,
+			this, &LdapNetworkObjectDirectory::processQueryResults);
+	connect(&m_ldapDirectory.client(), &LdapClient::queryFinished,
+			this, &LdapNetworkObjectDirectory::finishQuery);
 }
 
 
@@ -69,6 +113,22 @@ NetworkObjectList LdapNetworkObjectDirectory::queryParents(const NetworkObject&
 
 void LdapNetworkObjectDirectory::update()
 {
+	if (m_ldapDirectory.computerLocationsByContainer() && m_ldapDirectory.mapContainerStructureToLocations())
+	{
+		if (m_incrementalSynchronization &&
+			m_synchronizationTimestamp.isEmpty() == false &&
+			m_fullSynchronizationTimer.isValid() &&
+			m_fullSynchronizationTimer.hasExpired(qint64(m_fullSynchronizationInterval) * 1000) == false)
+		{
+			synchronizeChanges();
+		}
+		else
+		{
+			synchronizeAll();
+		}
+		return;
+	}
+
 	updateObjects(rootObject());
 
 	setObjectPopulated(rootObject());
@@ -86,6 +146,10 @@ void LdapNetworkObjectDirectory::fetchObjects(const NetworkObject& parent)
 	{
 		setObjectPopulated(parent);
 	}
+	else if (m_ldapDirectory.computerLocationsByContainer() && m_ldapDirectory.mapContainerStructureToLocations())
+	{
+		updateObjectsAsync(parent);
+	}
 	else
 	{
 		updateObjects(parent);
@@ -98,40 +162,37 @@ void LdapNetworkObjectDirectory::fetchObjects(const NetworkObject& parent)
 
 void LdapNetworkObjectDirectory::updateObjects(const NetworkObject& parent)
 {
-	if (m_ldapDirectory.computerLocationsByContainer() && m_ldapDirectory.mapContainerStructureToLocations())
-	{
-		updateLocations(parent);
-		updateComputers(parent);
-	}
-	else if (parent.type() == NetworkObject::Type::Root)
+	if (parent.type() == NetworkObject::Type::Root)
 	{
 		const auto locationNames = m_ldapDirectory.computerLocations();
 
+		NetworkObjectList locations;
+		locations.reserve(locationNames.count());
+
 		for (const auto& locationName : std::as_const(locationNames))
 		{
-			addOrUpdateObject(NetworkObject{this, NetworkObject::Type::Location, locationName}, parent);
+			locations.append(NetworkObject{this, NetworkObject::Type::Location, locationName});
 		}
 
-		removeObjects(parent, [&locationNames](const NetworkObject& object) {
-			return object.type() == NetworkObject::Type::Location && locationNames.contains(object.name()) == false; });
+		replaceObjects(locations, parent);
 	}
 	else
 	{
 		const auto computerDns = m_ldapDirectory.computerLocationEntries(parent.name());
 
+		NetworkObjectList computers;
+		computers.reserve(computerDns.count());
+
 		for (const auto& computerDn : std::as_const(computerDns))
 		{
 			const auto hostObject = computerToObject(computerDn);
 			if (hostObject.type() == NetworkObject::Type::Host)
 			{
-				addOrUpdateObject(hostObject, parent);
+				computers.append(hostObject);
 			}
 		}
 
-		removeObjects(parent, [&computerDns](const NetworkObject& object) {
-			return object.type() == NetworkObject::Type::Host &&
-					computerDns.contains(object.property(NetworkObject::Property::DirectoryAddress).toString()) == false;
-		});
+		replaceObjects(computers, parent);
 	}
 }
 
@@ -150,6 +211,24 @@ NetworkObjectList LdapNetworkObjectDirectory::queryLocations(NetworkObject::Prop
 		name = value.toString();
 		break;
 
+	case NetworkObject::Property::DirectoryAddress:
+		if (m_ldapDirectory.computerLocationsByContainer())
+		{
+			// resolve the display name of a container which is referenced by its DN only, e.g. by queryParents()
+			const auto containerDn = value.toString();
+			const auto containerName = m_ldapDirectory.client().queryAttributeValues(containerDn,
+																					  m_ldapDirectory.locationNameAttribute()).value(0);
+			if (containerName.isEmpty())
+			{
+				return {};
+			}
+
+			return {NetworkObject{this, NetworkObject::Type::Location, containerName, {
+						{ NetworkObject::propertyKey(NetworkObject::Property::DirectoryAddress), containerDn}
+					}}};
+		}
+		return {};
+
 	default:
 		vCritical() << "Can't query locations by property" << property;
 		return {};
@@ -217,54 +296,307 @@ NetworkObjectList LdapNetworkObjectDirectory::queryHosts(NetworkObject::Property
 
 
 
-void LdapNetworkObjectDirectory::updateLocations(const NetworkObject& parent)
+void LdapNetworkObjectDirectory::updateObjectsAsync(const NetworkObject& parent)
 {
-	auto baseDn = parent.property(NetworkObject::Property::DirectoryAddress).toString();
-	if (parent.type() == NetworkObject::Type::Root)
+	if (m_pendingUpdates.contains(parent.modelId()))
 	{
-		baseDn = m_ldapDirectory.computersDn();
+		// previous update still in progress
+		return;
 	}
 
-	const auto locations = m_ldapDirectory.client().queryObjects(baseDn, { m_ldapDirectory.locationNameAttribute() },
-																 m_ldapDirectory.computerContainersFilter(), LdapClient::Scope::One);
-	for (auto it = locations.begin(), end = locations.end(); it != end; ++it)
+	const auto baseDn = containerDn(parent);
+	auto& client = m_ldapDirectory.client();
+
+	QStringList locationAttributes{m_ldapDirectory.locationNameAttribute()};
+	auto hostAttributes = computerAttributes();
+	if (m_incrementalSynchronization)
+	{
+		locationAttributes.append(modifyTimestampAttribute());
+		hostAttributes.append(modifyTimestampAttribute());
+	}
+
+	const auto locationsQueryId = client.queryObjectsAsync(baseDn, locationAttributes,
+														   m_ldapDirectory.computerContainersFilter(), LdapClient::Scope::One);
+	const auto computersQueryId = client.queryObjectsAsync(baseDn, hostAttributes,
+														   m_ldapDirectory.computersFilter(), LdapClient::Scope::One);
+
+	if (locationsQueryId == LdapClient::InvalidQueryId || computersQueryId == LdapClient::InvalidQueryId)
+	{
+		client.cancelQuery(locationsQueryId);
+		client.cancelQuery(computersQueryId);
+		setObjectPopulated(parent);
+		return;
+	}
+
+	m_pendingQueries[locationsQueryId] = {parent.modelId(), NetworkObject::Type::Location};
+	m_pendingQueries[computersQueryId] = {parent.modelId(), NetworkObject::Type::Host};
+	m_pendingUpdates[parent.modelId()] = {parent, {}, 2, true};
+}
+
+
+
+void LdapNetworkObjectDirectory::synchronizeAll()
+{
+	m_fullSynchronizationTimer.restart();
+
+	// refresh all containers which have been fetched so far
+	NetworkObjectList containers{rootObject()};
+	for (int i = 0; i < containers.count(); ++i)
+	{
+		const auto children = objects(containers[i]);
+		for (const auto& child : children)
+		{
+			if (child.type() == NetworkObject::Type::Location && child.isPopulated())
+			{
+				containers.append(child);
+			}
+		}
+	}
+
+	for (const auto& container : std::as_const(containers))
+	{
+		if (m_queuedUpdates.contains(container.modelId()) == false)
+		{
+			m_queuedUpdates.append(container.modelId());
+		}
+	}
+
+	startQueuedUpdates();
+}
+
+
+
+void LdapNetworkObjectDirectory::startQueuedUpdates()
+{
+	// limit the number of concurrent searches instead of querying all containers at once
+	while (m_queuedUpdates.isEmpty() == false && m_pendingUpdates.count() < MaximumConcurrentUpdates)
+	{
+		const auto objectId = m_queuedUpdates.takeFirst();
+		const auto container = objectId == rootId() ? rootObject() : object(parentId(objectId), objectId);
+
+		// container may have been removed in the meantime
+		if (container.isValid())
+		{
+			updateObjectsAsync(container);
+		}
+	}
+}
+
+
+
+void LdapNetworkObjectDirectory::synchronizeChanges()
+{
+	if (m_pendingSynchronizationQueries > 0)
+	{
+		// previous synchronization still in progress
+		return;
+	}
+
+	const auto changeFilter = QStringLiteral("(%1>=%2)").arg(modifyTimestampAttribute(),
+															  LdapClient::escapeFilterValue(m_synchronizationTimestamp));
+	const auto filter = [&changeFilter](const QString& extraFilter) {
+		return extraFilter.isEmpty() ? changeFilter : QStringLiteral("(&%1%2)").arg(extraFilter, changeFilter);
+	};
+
+	const auto baseDn = m_ldapDirectory.computersDn();
+	auto& client = m_ldapDirectory.client();
+
+	const auto locationsQueryId = client.queryObjectsAsync(baseDn,
+														   {m_ldapDirectory.locationNameAttribute(), modifyTimestampAttribute()},
+														   filter(m_ldapDirectory.computerContainersFilter()),
+														   LdapClient::Scope::Sub);
+	const auto computersQueryId = client.queryObjectsAsync(baseDn,
+														   computerAttributes() + QStringList{modifyTimestampAttribute()},
+														   filter(m_ldapDirectory.computersFilter()),
+														   LdapClient::Scope::Sub);
+
+	if (locationsQueryId == LdapClient::InvalidQueryId || computersQueryId == LdapClient::InvalidQueryId)
+	{
+		client.cancelQuery(locationsQueryId);
+		client.cancelQuery(computersQueryId);
+		return;
+	}
+
+	m_pendingQueries[locationsQueryId] = {rootId(), NetworkObject::Type::Location, true};
+	m_pendingQueries[computersQueryId] = {rootId(), NetworkObject::Type::Host, true};
+	m_pendingSynchronizationQueries = 2;
+	m_pendingSynchronizationTimestamp = m_synchronizationTimestamp;
+	m_synchronizationSuccess = true;
+}
+
+
+
+void LdapNetworkObjectDirectory::processQueryResults(LdapClient::QueryId queryId, const LdapClient::Objects& objects)
+{
+	const auto query = m_pendingQueries.constFind(queryId);
+	if (query == m_pendingQueries.constEnd())
+	{
+		return;
+	}
+
+	if (query->incremental)
+	{
+		processChanges(objects, query->objectType);
+		return;
+	}
+
+	updateTimestamp(objects, m_synchronizationTimestamp);
+
+	auto& pendingUpdate = m_pendingUpdates[query->parentId];
+
+	const auto networkObjects = query->objectType == NetworkObject::Type::Location ? locationObjects(objects)
+																				   : computerObjects(objects);
+	for (const auto& networkObject : networkObjects)
+	{
+		pendingUpdate.objectUids.insert(networkObject.uid());
+	}
+
+	// make results available immediately while the remaining pages are still being fetched
+	addOrUpdateObjects(networkObjects, pendingUpdate.parent);
+}
+
+
+
+void LdapNetworkObjectDirectory::finishQuery(LdapClient::QueryId queryId, bool success)
+{
+	const auto query = m_pendingQueries.constFind(queryId);
+	if (query == m_pendingQueries.constEnd())
 	{
-		for (const auto& locationName : std::as_const(it.value().first()))
+		return;
+	}
+
+	const auto parentId = query->parentId;
+	const auto incremental = query->incremental;
+	m_pendingQueries.erase(query);
+
+	if (incremental)
+	{
+		m_synchronizationSuccess = m_synchronizationSuccess && success;
+		if (--m_pendingSynchronizationQueries <= 0)
+		{
+			finishSynchronization(m_synchronizationSuccess);
+		}
+		return;
+	}
+
+	if (success == false)
+	{
+		// objects may be incomplete so do not rely on changes since the last timestamp seen
+		m_synchronizationTimestamp.clear();
+	}
+
+	auto& pendingUpdate = m_pendingUpdates[parentId];
+	pendingUpdate.success = pendingUpdate.success && success;
+	if (--pendingUpdate.pendingQueries > 0)
+	{
+		return;
+	}
+
+	const auto update = m_pendingUpdates.take(parentId);
+
+	// keep previous objects if the directory could not be queried completely
+	if (update.success)
+	{
+		removeObjects(update.parent, [&update](const NetworkObject& object) {
+			return update.objectUids.contains(object.uid()) == false; });
+	}
+
+	setObjectPopulated(update.parent);
+
+	Q_EMIT objectsFetched(parentId);
+
+	startQueuedUpdates();
+}
+
+
+
+void LdapNetworkObjectDirectory::processChanges(const LdapClient::Objects& objects, NetworkObject::Type objectType)
+{
+	updateTimestamp(objects, m_pendingSynchronizationTimestamp);
+
+	// group changed entries by their containers
+	QMap<QString, LdapClient::Objects> objectsByParentDn;
+	for (auto it = objects.constBegin(), end = objects.constEnd(); it != end; ++it)
+	{
+		objectsByParentDn[LdapClient::parentDn(it.key()).toLower()].insert(it.key(), it.value());
+	}
+
+	const auto computersDn = m_ldapDirectory.computersDn();
+
+	for (auto it = objectsByParentDn.constBegin(), end = objectsByParentDn.constEnd(); it != end; ++it)
+	{
+		auto parent = rootObject();
+
+		if (QString::compare(it.key(), computersDn, Qt::CaseInsensitive) != 0)
+		{
+			const auto parentDn = LdapClient::parentDn(it.value().firstKey());
+			const NetworkObject container{this, NetworkObject::Type::Location, {}, {
+					{ NetworkObject::propertyKey(NetworkObject::Property::DirectoryAddress), parentDn}
+				}};
+			parent = object(parentId(container.modelId()), container.modelId());
+		}
+
+		// containers which have not been fetched yet will be fetched completely on demand
+		if (parent.isValid() == false || parent.isPopulated() == false)
 		{
-			addOrUpdateObject(NetworkObject{
-								  this, NetworkObject::Type::Location, locationName, {
-									  { NetworkObject::propertyKey(NetworkObject::Property::DirectoryAddress), it.key()},
-								  }
-							  },
-							  parent);
+			continue;
 		}
+
+		addOrUpdateObjects(objectType == NetworkObject::Type::Location ? locationObjects(it.value())
+																		: computerObjects(it.value()),
+						   parent);
+
+		m_synchronizedParentIds.insert(parent.modelId());
+	}
+}
+
+
+
+void LdapNetworkObjectDirectory::finishSynchronization(bool success)
+{
+	if (success)
+	{
+		m_synchronizationTimestamp = m_pendingSynchronizationTimestamp;
+	}
+	else
+	{
+		// e.g. the server does not support filtering by modifyTimestamp
+		vWarning() << "incremental synchronization failed - falling back to full synchronization";
+		m_synchronizationTimestamp.clear();
 	}
 
-	const auto locationDNs = locations.keys();
+	const auto parentIds = m_synchronizedParentIds;
+	m_synchronizedParentIds.clear();
 
-	removeObjects(parent, [locationDNs](const NetworkObject& object) {
-		return object.type() == NetworkObject::Type::Location &&
-				locationDNs.contains(object.property(NetworkObject::Property::DirectoryAddress).toString()) == false; });
+	for (const auto parentId : parentIds)
+	{
+		Q_EMIT objectsFetched(parentId);
+	}
 }
 
 
 
-void LdapNetworkObjectDirectory::updateComputers(const NetworkObject& parent)
+QString LdapNetworkObjectDirectory::containerDn(const NetworkObject& parent)
 {
-	auto baseDn = parent.property(NetworkObject::Property::DirectoryAddress).toString();
 	if (parent.type() == NetworkObject::Type::Root)
 	{
-		baseDn = m_ldapDirectory.computersDn();
+		return m_ldapDirectory.computersDn();
 	}
 
-	const auto displayNameAttribute = m_ldapDirectory.computerDisplayNameAttribute();
+	return parent.property(NetworkObject::Property::DirectoryAddress).toString();
+}
+
+
+
+QStringList LdapNetworkObjectDirectory::computerAttributes() const
+{
 	auto hostNameAttribute = m_ldapDirectory.computerHostNameAttribute();
 	if (hostNameAttribute.isEmpty())
 	{
 		hostNameAttribute = LdapClient::cn();
 	}
 
-	QStringList computerAttributes{displayNameAttribute, hostNameAttribute};
+	QStringList computerAttributes{m_ldapDirectory.computerDisplayNameAttribute(), hostNameAttribute};
 
 	const auto macAddressAttribute = m_ldapDirectory.computerMacAddressAttribute();
 	if (macAddressAttribute.isEmpty() == false)
@@ -274,10 +606,47 @@ void LdapNetworkObjectDirectory::updateComputers(const NetworkObject& parent)
 
 	computerAttributes.removeDuplicates();
 
-	const auto computers = m_ldapDirectory.client().queryObjects(baseDn, computerAttributes,
-																 m_ldapDirectory.computersFilter(), LdapClient::Scope::One);
+	return computerAttributes;
+}
+
 
-	QStringList computerDns;
+
+NetworkObjectList LdapNetworkObjectDirectory::locationObjects(const LdapClient::Objects& locations)
+{
+	NetworkObjectList locationObjects;
+	locationObjects.reserve(locations.count());
+
+	for (auto it = locations.begin(), end = locations.end(); it != end; ++it)
+	{
+		const auto locationNames = attributeValues(it.value(), m_ldapDirectory.locationNameAttribute());
+		for (const auto& locationName : locationNames)
+		{
+			locationObjects.append(NetworkObject{
+									   this, NetworkObject::Type::Location, locationName, {
+										   { NetworkObject::propertyKey(NetworkObject::Property::DirectoryAddress), it.key()},
+									   }
+								   });
+		}
+	}
+
+	return locationObjects;
+}
+
+
+
+NetworkObjectList LdapNetworkObjectDirectory::computerObjects(const LdapClient::Objects& computers)
+{
+	const auto displayNameAttribute = m_ldapDirectory.computerDisplayNameAttribute();
+	auto hostNameAttribute = m_ldapDirectory.computerHostNameAttribute();
+	if (hostNameAttribute.isEmpty())
+	{
+		hostNameAttribute = LdapClient::cn();
+	}
+
+	const auto macAddressAttribute = m_ldapDirectory.computerMacAddressAttribute();
+
+	NetworkObjectList computerObjects;
+	computerObjects.reserve(computers.count());
 
 	for (auto it = computers.begin(), end = computers.end(); it != end; ++it)
 	{
@@ -285,21 +654,15 @@ void LdapNetworkObjectDirectory::updateComputers(const NetworkObject& parent)
 		const auto hostName = it.value()[hostNameAttribute].value(0);
 		const auto macAddress = (macAddressAttribute.isEmpty() == false) ? it.value()[hostNameAttribute].value(0) : QString();
 
-		addOrUpdateObject(NetworkObject{this, NetworkObject::Type::Host, displayName, {
-											{ NetworkObject::propertyKey(NetworkObject::Property::HostAddress), hostName},
-											{ NetworkObject::propertyKey(NetworkObject::Property::MacAddress), macAddress},
-											{ NetworkObject::propertyKey(NetworkObject::Property::DirectoryAddress), it.key()},
-										}
-						  },
-						  parent);
-
-		computerDns.append(it.key());
+		computerObjects.append(NetworkObject{this, NetworkObject::Type::Host, displayName, {
+												 { NetworkObject::propertyKey(NetworkObject::Property::HostAddress), hostName},
+												 { NetworkObject::propertyKey(NetworkObject::Property::MacAddress), macAddress},
+												 { NetworkObject::propertyKey(NetworkObject::Property::DirectoryAddress), it.key()},
+											 }
+							   });
 	}
 
-	removeObjects(parent, [computerDns](const NetworkObject& object) {
-		return object.type() == NetworkObject::Type::Host &&
-				computerDns.contains(object.property(NetworkObject::Property::DirectoryAddress).toString()) == false;
-	});
+	return computerObjects;
 }
 
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <QElapsedTimer>
+
 #include "LdapDirectory.h"
 #include "NetworkObjectDirectory.h"
 
@@ -24,13 +26,56 @@ private:
 	void fetchObjects(const NetworkObject& parent) override;
 
 	void updateObjects(const NetworkObject& parent);
+	void updateObjectsAsync(const NetworkObject& parent);
+	void synchronizeAll();
+	void startQueuedUpdates();
+	void synchronizeChanges();
+	void processQueryResults(LdapClient::QueryId queryId, const LdapClient::Objects& objects);
+	void finishQuery(LdapClient::QueryId queryId, bool success);
+	void processChanges(const LdapClient::Objects& objects, NetworkObject::Type objectType);
+	void finishSynchronization(bool success);
 
 	NetworkObjectList queryLocations(NetworkObject::Property property, const QVariant& value);
 	NetworkObjectList queryHosts(NetworkObject::Property property, const QVariant& value);
 
-	void updateLocations(const NetworkObject& parent);
-	void updateComputers(const NetworkObject& parent);
+	QString containerDn(const NetworkObject& parent);
+	QStringList computerAttributes() const;
+
+	NetworkObjectList locationObjects(const LdapClient::Objects& locations);
+	NetworkObjectList computerObjects(const LdapClient::Objects& computers);
+
+	struct PendingQuery
+	{
+		NetworkObject::ModelId parentId;
+		NetworkObject::Type objectType;
+		bool incremental{false};
+	};
+
+	struct PendingUpdate
+	{
+		NetworkObject parent;
+		QSet<NetworkObject::Uid> objectUids{};
+		int pendingQueries{0};
+		bool success{true};
+	};
+
+	static constexpr auto MaximumConcurrentUpdates = 4;
 
 	LdapDirectory m_ldapDirectory;
 
+	QHash<LdapClient::QueryId, PendingQuery> m_pendingQueries;
+	QHash<NetworkObject::ModelId, PendingUpdate> m_pendingUpdates;
+	QList<NetworkObject::ModelId> m_queuedUpdates;
+
+	// state of incremental synchronization based on the modifyTimestamp attribute - deleted and
+	// moved entries are not reported this way, so a full synchronization is performed regularly
+	const bool m_incrementalSynchronization;
+	const int m_fullSynchronizationInterval;
+	QElapsedTimer m_fullSynchronizationTimer;
+	QString m_synchronizationTimestamp;
+	QString m_pendingSynchronizationTimestamp;
+	int m_pendingSynchronizationQueries{0};
+	bool m_synchronizationSuccess{true};
+	QSet<NetworkObject::ModelId> m_synchronizedParentIds;
+
 };
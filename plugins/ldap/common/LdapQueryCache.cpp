@@ -0,0 +1,190 @@
+// Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+// This file is part of Veyon - https://veyon.io
+// SPDX-License-Identifier: LGPL-2.0-or-later
+
+#include "LdapQueryCache.h"
+#include "VeyonCore.h"
+
+
+LdapQueryCache& LdapQueryCache::instance()
+{
+	static LdapQueryCache cache;
+	return cache;
+}
+
+
+
+QStringList LdapQueryCache::lookup( const QString& configInstanceId, QueryType type, const QString& key,
+									int timeout, int negativeTimeout, const Query& query )
+{
+	if( timeout <= 0 && negativeTimeout <= 0 )
+	{
+		bool success = true;
+		return query( success );
+	}
+
+	// LDAP attribute values are compared case-insensitively in general
+	const auto cacheKey = configInstanceId + QLatin1Char('\n') + key.toLower();
+	const auto typeIndex = int(type);
+
+	auto& entries = m_entries[typeIndex];
+	auto& pendingQueries = m_pendingQueries[typeIndex];
+	auto& statistics = m_statistics[typeIndex];
+
+	QMutexLocker locker( &m_mutex );
+
+	if( m_statisticsLogDeadline.hasExpired() )
+	{
+		logStatistics();
+		m_statisticsLogDeadline.setRemainingTime( std::chrono::seconds( StatisticsLogInterval ) );
+	}
+
+	for(;;)
+	{
+		const auto it = entries.constFind( cacheKey );
+		if( it != entries.constEnd() )
+		{
+			if( it->expiry.hasExpired() == false )
+			{
+				if( it->values.isEmpty() )
+				{
+					++statistics.negativeHits;
+				}
+				else
+				{
+					++statistics.hits;
+				}
+				return it->values;
+			}
+
+			entries.erase( it );
+			++statistics.expiredEntries;
+		}
+
+		if( pendingQueries.contains( cacheKey ) == false )
+		{
+			break;
+		}
+
+		++statistics.deduplicatedQueries;
+		m_pendingQueriesFinished.wait( &m_mutex );
+	}
+
+	++statistics.misses;
+	pendingQueries.insert( cacheKey );
+	const auto generation = m_generation;
+
+	locker.unlock();
+	bool success = true;
+	const auto values = query( success );
+	locker.relock();
+
+	pendingQueries.remove( cacheKey );
+
+	// do not cache failed queries (e.g. due to connection problems) as if nothing was found
+	// and discard results of queries which were started before the cache was cleared
+	const auto entryTimeout = values.isEmpty() ? negativeTimeout : timeout;
+	if( success && generation == m_generation && entryTimeout > 0 )
+	{
+		if( entries.size() >= MaximumEntryCount )
+		{
+			purgeExpiredEntries();
+		}
+
+		entries[cacheKey] = { values, QDeadlineTimer( std::chrono::seconds( entryTimeout ) ) };
+	}
+
+	m_pendingQueriesFinished.wakeAll();
+
+	return values;
+}
+
+
+
+void LdapQueryCache::clear()
+{
+	QMutexLocker locker( &m_mutex );
+
+	for( auto& entries : m_entries )
+	{
+		entries.clear();
+	}
+
+	++m_generation;
+}
+
+
+
+LdapQueryCache::Statistics LdapQueryCache::statistics( QueryType type ) const
+{
+	QMutexLocker locker( &m_mutex );
+
+	auto statistics = m_statistics[int(type)];
+	statistics.entries = m_entries[int(type)].size();
+
+	return statistics;
+}
+
+
+
+QString LdapQueryCache::queryTypeName( QueryType type )
+{
+	switch( type )
+	{
+	case QueryType::Users: return QStringLiteral("users");
+	case QueryType::UserGroups: return QStringLiteral("user groups");
+	case QueryType::Computers: return QStringLiteral("computers");
+	case QueryType::ComputerGroups: return QStringLiteral("computer groups");
+	case QueryType::ComputerLocations: return QStringLiteral("computer locations");
+	default:
+		break;
+	}
+
+	return {};
+}
+
+
+
+void LdapQueryCache::purgeExpiredEntries()
+{
+	for( int typeIndex = 0; typeIndex < int(QueryType::Count); ++typeIndex )
+	{
+		auto& entries = m_entries[typeIndex];
+		for( auto it = entries.begin(); it != entries.end(); )
+		{
+			if( it->expiry.hasExpired() )
+			{
+				it = entries.erase( it );
+				++m_statistics[typeIndex].expiredEntries;
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		// still too many entries (e.g. when scanning many hosts) so start over
+		if( entries.size() >= MaximumEntryCount )
+		{
+			m_statistics[typeIndex].expiredEntries += quint64(entries.size());
+			entries.clear();
+		}
+	}
+}
+
+
+
+void LdapQueryCache::logStatistics() const
+{
+	for( int typeIndex = 0; typeIndex < int(QueryType::Count); ++typeIndex )
+	{
+		const auto& statistics = m_statistics[typeIndex];
+		vInfo() << "LDAP query cache statistics for" << queryTypeName( QueryType(typeIndex) ) << "-"
+				<< "entries:" << m_entries[typeIndex].size()
+				<< "hits:" << statistics.hits
+				<< "negative hits:" << statistics.negativeHits
+				<< "misses:" << statistics.misses
+				<< "deduplicated:" << statistics.deduplicatedQueries
+				<< "expired:" << statistics.expiredEntries;
+	}
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2025 Tobias Junghans <tobydox@veyon.io>
+// This file is part of Veyon - https://veyon.io
+// SPDX-License-Identifier: LGPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+
+#include <QDeadlineTimer>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QStringList>
+#include <QWaitCondition>
+
+#include "LdapCommon.h"
+
+// process-wide cache for LDAP lookups which are performed repeatedly, e.g. while evaluating access control rules
+class LDAP_COMMON_EXPORT LdapQueryCache
+{
+public:
+	enum class QueryType {
+		Users,
+		UserGroups,
+		Computers,
+		ComputerGroups,
+		ComputerLocations,
+		Count
+	};
+
+	struct Statistics
+	{
+		int entries{0};
+		quint64 hits{0};
+		quint64 negativeHits{0};
+		quint64 misses{0};
+		quint64 deduplicatedQueries{0};
+		quint64 expiredEntries{0};
+	};
+
+	// the query sets success to false if it failed, so that its (empty) result is not cached
+	using Query = std::function<QStringList(bool& success)>;
+
+	static LdapQueryCache& instance();
+
+	// returns cached results for given key or runs the query - concurrent lookups for the same
+	// key wait for the first query to finish instead of sending identical queries to the server
+	QStringList lookup( const QString& configInstanceId, QueryType type, const QString& key,
+						int timeout, int negativeTimeout, const Query& query );
+
+	void clear();
+
+	Statistics statistics( QueryType type ) const;
+
+	static QString queryTypeName( QueryType type );
+
+private:
+	static constexpr auto MaximumEntryCount = 10000;
+	static constexpr auto StatisticsLogInterval = 600;
+
+	struct Entry
+	{
+		QStringList values;
+		QDeadlineTimer expiry;
+	};
+
+	LdapQueryCache() = default;
+
+	void purgeExpiredEntries();
+	void logStatistics() const;
+
+	mutable QMutex m_mutex;
+	QWaitCondition m_pendingQueriesFinished;
+	QHash<QString, Entry> m_entries[int(QueryType::Count)];
+	QSet<QString> m_pendingQueries[int(QueryType::Count)];
+	// incremented by clear() so that results of queries started before are discarded
+	quint64 m_generation{0};
+	Statistics m_statistics[int(QueryType::Count)];
+	// statistics are logged regularly so they can be inspected for long-running processes such as the service
+	QDeadlineTimer m_statisticsLogDeadline{std::chrono::seconds(StatisticsLogInterval)};
+
+};
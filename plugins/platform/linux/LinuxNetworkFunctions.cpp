@@ -24,12 +24,15 @@
 
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 #include <QFile>
 #include <QProcess>
 #include <QRegularExpression>
 
 #include "LinuxNetworkFunctions.h"
+#include "LinuxUserFunctions.h"
 #include "ProcessHelper.h"
 
 LinuxNetworkFunctions::PingResult LinuxNetworkFunctions::ping(const QString& hostAddress)
@@ -104,6 +107,47 @@ bool LinuxNetworkFunctions::configureSocketKeepalive( Socket socket, bool enable
 
 
 
+bool LinuxNetworkFunctions::isLocalSocketPeerTrusted( Socket socket )
+{
+	ucred credentials{};
+	socklen_t credentialsLength = sizeof(credentials);
+
+	if( getsockopt( static_cast<int>( socket ), SOL_SOCKET, SO_PEERCRED, &credentials, &credentialsLength ) < 0 )
+	{
+		vWarning() << "could not query peer credentials";
+		return false;
+	}
+
+	if( credentials.uid == 0 || credentials.uid == geteuid() )
+	{
+		return true;
+	}
+
+	const auto currentUser = VeyonCore::platform().userFunctions().currentUser();
+
+	return currentUser.isEmpty() == false &&
+		   credentials.uid == LinuxUserFunctions::userIdFromName( currentUser );
+}
+
+
+
+bool LinuxNetworkFunctions::isLocalSocketServerTrusted( Socket socket )
+{
+	// SO_PEERCRED returns the credentials of the listening process for connected client sockets
+	ucred credentials{};
+	socklen_t credentialsLength = sizeof(credentials);
+
+	if( getsockopt( static_cast<int>( socket ), SOL_SOCKET, SO_PEERCRED, &credentials, &credentialsLength ) < 0 )
+	{
+		vWarning() << "could not query server credentials";
+		return false;
+	}
+
+	return credentials.uid == 0 || credentials.uid == geteuid();
+}
+
+
+
 QNetworkInterface LinuxNetworkFunctions::defaultRouteNetworkInterface()
 {
 	const auto routes = ProcessHelper(QStringLiteral("ip"), {QStringLiteral("route")}).runAndReadAll().split('\n') +
@@ -337,6 +337,81 @@ bool WindowsNetworkFunctions::configureSocketKeepalive( Socket socket, bool enab
 
 
 
+bool WindowsNetworkFunctions::isLocalSocketPeerTrusted( Socket socket )
+{
+	// local sockets are named pipes on Windows - only accept clients running in the same session
+	ULONG clientProcessId = 0;
+	if( GetNamedPipeClientProcessId( reinterpret_cast<HANDLE>( socket ), &clientProcessId ) == false )
+	{
+		vWarning() << "could not query named pipe client process ID" << GetLastError();
+		return false;
+	}
+
+	DWORD clientSessionId = 0;
+	DWORD ownSessionId = 0;
+
+	return ProcessIdToSessionId( clientProcessId, &clientSessionId ) &&
+		   ProcessIdToSessionId( GetCurrentProcessId(), &ownSessionId ) &&
+		   clientSessionId == ownSessionId;
+}
+
+
+
+static QByteArray processUserSid( DWORD processId )
+{
+	const auto process = OpenProcess( PROCESS_QUERY_LIMITED_INFORMATION, false, processId );
+	if( process == nullptr )
+	{
+		return {};
+	}
+
+	HANDLE token = nullptr;
+	QByteArray sid;
+
+	if( OpenProcessToken( process, TOKEN_QUERY, &token ) )
+	{
+		DWORD tokenSize = 0;
+		GetTokenInformation( token, TokenUser, nullptr, 0, &tokenSize );
+
+		QByteArray tokenInformation( int(tokenSize), 0 );
+		if( tokenSize > 0 &&
+			GetTokenInformation( token, TokenUser, tokenInformation.data(), tokenSize, &tokenSize ) )
+		{
+			const auto userSid = reinterpret_cast<PTOKEN_USER>( tokenInformation.data() )->User.Sid;
+			sid = QByteArray( reinterpret_cast<const char *>( userSid ), int( GetLengthSid( userSid ) ) );
+		}
+
+		CloseHandle( token );
+	}
+
+	CloseHandle( process );
+
+	return sid;
+}
+
+
+
+bool WindowsNetworkFunctions::isLocalSocketServerTrusted( Socket socket )
+{
+	// named pipes can be created by any user first - only trust servers running as LocalSystem
+	// (i.e. Veyon Server) or as the same user as this process
+	ULONG serverProcessId = 0;
+	if( GetNamedPipeServerProcessId( reinterpret_cast<HANDLE>( socket ), &serverProcessId ) == false )
+	{
+		vWarning() << "could not query named pipe server process ID" << GetLastError();
+		return false;
+	}
+
+	auto serverSid = processUserSid( serverProcessId );
+	const auto ownSid = processUserSid( GetCurrentProcessId() );
+
+	return serverSid.isEmpty() == false &&
+		   ( IsWellKnownSid( reinterpret_cast<PSID>( serverSid.data() ), WinLocalSystemSid ) ||
+			 serverSid == ownSid );
+}
+
+
+
 QNetworkInterface WindowsNetworkFunctions::defaultRouteNetworkInterface()
 {
 	QNetworkInterface networkInterface;
@@ -39,6 +39,8 @@ public:
 	bool configureFirewallException( const QString& applicationPath, const QString& description, bool enabled ) override;
 
 	bool configureSocketKeepalive( Socket socket, bool enabled, int idleTime, int interval, int probes ) override;
+	bool isLocalSocketPeerTrusted( Socket socket ) override;
+	bool isLocalSocketServerTrusted( Socket socket ) override;
 
 	QNetworkInterface defaultRouteNetworkInterface() override;
 	int networkInterfaceSpeedInMBitPerSecond(const QNetworkInterface& networkInterface) override;
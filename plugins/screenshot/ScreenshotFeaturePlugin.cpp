@@ -22,6 +22,8 @@
  *
  */
 
+#include <algorithm>
+
 #include <QMessageBox>
 #include <QQmlEngine>
 
@@ -43,6 +45,10 @@ ScreenshotFeaturePlugin::ScreenshotFeaturePlugin( QObject* parent ) :
 								  QStringLiteral(":/screenshot/camera-photo.png") ) ),
 	m_features( { m_screenshotFeature } )
 {
+	m_framebufferRefreshTimer.setSingleShot( true );
+	m_framebufferRefreshTimer.setInterval( FramebufferRefreshTimeout );
+	connect( &m_framebufferRefreshTimer, &QTimer::timeout, this, &ScreenshotFeaturePlugin::takePendingScreenshots );
+
 	if( VeyonCore::component() == VeyonCore::Component::Master )
 	{
 		connect( VeyonCore::instance(), &VeyonCore::applicationLoaded,
@@ -69,7 +75,43 @@ bool ScreenshotFeaturePlugin::controlFeature( Feature::Uid featureUid,
 	{
 		for( const auto& controlInterface : computerControlInterfaces )
 		{
-			Screenshot().take( controlInterface );
+			if( m_pendingScreenshots.contains( controlInterface ) )
+			{
+				continue;
+			}
+
+			// resume suspended framebuffer updates so the screenshot shows the current screen content
+			controlInterface->setFramebufferInUse( this, true );
+
+			if( controlInterface->refreshFramebuffer() )
+			{
+				// take the screenshot once a fresh frame has been received instead of waiting for it here
+				m_pendingScreenshots.append( controlInterface );
+
+				const auto pendingInterface = controlInterface.data();
+				connect( pendingInterface, &ComputerControlInterface::scaledFramebufferUpdated, this, [=]() {
+					if( pendingInterface->isFramebufferOutdated() == false )
+					{
+						takePendingScreenshot( pendingInterface );
+					}
+				} );
+				connect( pendingInterface, &ComputerControlInterface::stateChanged, this, [=]() {
+					if( pendingInterface->state() != ComputerControlInterface::State::Connected )
+					{
+						takePendingScreenshot( pendingInterface );
+					}
+				} );
+			}
+			else
+			{
+				takeScreenshot( controlInterface );
+			}
+		}
+
+		// all pending computers share a single timeout
+		if( m_pendingScreenshots.isEmpty() == false && m_framebufferRefreshTimer.isActive() == false )
+		{
+			m_framebufferRefreshTimer.start();
 		}
 
 		return true;
@@ -85,10 +127,14 @@ bool ScreenshotFeaturePlugin::startFeature( VeyonMasterInterface& master, const
 {
 	if( controlFeature( feature.uid(), Operation::Start, {}, computerControlInterfaces ) )
 	{
-		QMessageBox::information( master.mainWindow(),
-								  tr( "Screenshots taken" ),
-								  tr( "Screenshot of %1 computer have been taken successfully." ).
-								  arg( computerControlInterfaces.count() ) );
+		m_notificationParent = master.mainWindow();
+		m_notificationScreenshotCount += computerControlInterfaces.count();
+
+		// otherwise notify once the pending screenshots have been taken
+		if( m_pendingScreenshots.isEmpty() )
+		{
+			showScreenshotsTakenNotification();
+		}
 
 		return true;
 	}
@@ -98,6 +144,69 @@ bool ScreenshotFeaturePlugin::startFeature( VeyonMasterInterface& master, const
 
 
 
+void ScreenshotFeaturePlugin::takeScreenshot( const ComputerControlInterface::Pointer& controlInterface )
+{
+	Screenshot().take( controlInterface );
+
+	controlInterface->setFramebufferInUse( this, false );
+}
+
+
+
+void ScreenshotFeaturePlugin::takePendingScreenshot( const ComputerControlInterface* controlInterface )
+{
+	const auto it = std::find_if( m_pendingScreenshots.begin(), m_pendingScreenshots.end(),
+								  [controlInterface]( const ComputerControlInterface::Pointer& pendingInterface ) {
+									  return pendingInterface.data() == controlInterface;
+								  } );
+	if( it == m_pendingScreenshots.end() )
+	{
+		return;
+	}
+
+	const auto pendingInterface = *it;
+	m_pendingScreenshots.erase( it );
+
+	disconnect( pendingInterface.data(), nullptr, this, nullptr );
+
+	takeScreenshot( pendingInterface );
+
+	if( m_pendingScreenshots.isEmpty() )
+	{
+		m_framebufferRefreshTimer.stop();
+		showScreenshotsTakenNotification();
+	}
+}
+
+
+
+void ScreenshotFeaturePlugin::takePendingScreenshots()
+{
+	// take screenshots of computers which did not send a fresh frame in time with their last frame
+	const auto pendingScreenshots = m_pendingScreenshots;
+	for( const auto& controlInterface : pendingScreenshots )
+	{
+		takePendingScreenshot( controlInterface.data() );
+	}
+}
+
+
+
+void ScreenshotFeaturePlugin::showScreenshotsTakenNotification()
+{
+	if( m_notificationScreenshotCount > 0 )
+	{
+		const auto count = m_notificationScreenshotCount;
+		m_notificationScreenshotCount = 0;
+
+		QMessageBox::information( m_notificationParent,
+								  tr( "Screenshots taken" ),
+								  tr( "Screenshot of %1 computer have been taken successfully." ).arg( count ) );
+	}
+}
+
+
+
 void ScreenshotFeaturePlugin::initUi()
 {
 	auto master = VeyonCore::instance()->findChild<VeyonMasterInterface *>();
@@ -24,6 +24,10 @@
 
 #pragma once
 
+#include <QPointer>
+#include <QTimer>
+
+#include "ComputerControlInterface.h"
 #include "Feature.h"
 #include "FeatureProviderInterface.h"
 
@@ -76,9 +80,23 @@ public:
 
 
 private:
+	static constexpr int FramebufferRefreshTimeout = 3000;
+
 	void initUi();
 
+	void takeScreenshot( const ComputerControlInterface::Pointer& controlInterface );
+	void takePendingScreenshot( const ComputerControlInterface* controlInterface );
+	void takePendingScreenshots();
+	void showScreenshotsTakenNotification();
+
 	const Feature m_screenshotFeature;
 	const FeatureList m_features;
 
+	// computers whose screenshots are taken once a fresh frame has been received or the timeout has expired
+	ComputerControlInterfaceList m_pendingScreenshots;
+	QTimer m_framebufferRefreshTimer{this};
+
+	QPointer<QWidget> m_notificationParent;
+	int m_notificationScreenshotCount{0};
+
 };
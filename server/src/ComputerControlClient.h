@@ -55,6 +55,16 @@ public:
 
 	void setMinimumFramebufferUpdateInterval(int interval);
 
+	VeyonCore::ApplicationVersion applicationVersion() const
+	{
+		return m_applicationVersion;
+	}
+
+	void setApplicationVersion(VeyonCore::ApplicationVersion version)
+	{
+		m_applicationVersion = version;
+	}
+
 protected:
 	VncClientProtocol& clientProtocol() override
 	{
@@ -75,6 +85,7 @@ private:
 	VncClientProtocol m_clientProtocol;
 
 	int m_minimumFramebufferUpdateInterval{-1};
+	VeyonCore::ApplicationVersion m_applicationVersion{VeyonCore::ApplicationVersion::Unknown};
 	QElapsedTimer m_framebufferUpdateTimer;
 
 } ;
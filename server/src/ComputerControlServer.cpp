@@ -142,6 +142,12 @@ bool ComputerControlServer::sendFeatureMessageReply( const MessageContext& conte
 
 	if (context.ioDevice())
 	{
+		const auto client = qobject_cast<ComputerControlClient *>(context.connection());
+		if (client && client->applicationVersion() >= VeyonCore::ApplicationVersion::Version_5_0)
+		{
+			return FeatureMessage{reply}.setCompressionAllowed(true).sendAsRfbMessage(context.ioDevice());
+		}
+
 		return reply.sendAsRfbMessage(context.ioDevice());
 	}
 
@@ -161,6 +167,17 @@ void ComputerControlServer::setMinimumFramebufferUpdateInterval(const MessageCon
 
 
 
+void ComputerControlServer::setClientApplicationVersion(const MessageContext& context, VeyonCore::ApplicationVersion version)
+{
+	auto client = qobject_cast<ComputerControlClient *>(context.connection());
+	if (client)
+	{
+		client->setApplicationVersion(version);
+	}
+}
+
+
+
 void ComputerControlServer::checkForIncompleteAuthentication( VncServerClient* client )
 {
 	// connection to client closed during authentication?
@@ -76,6 +76,7 @@ public:
 	}
 
 	void setMinimumFramebufferUpdateInterval(const MessageContext& context, int interval) override;
+	void setClientApplicationVersion(const MessageContext& context, VeyonCore::ApplicationVersion version) override;
 
 private:
 	void checkForIncompleteAuthentication( VncServerClient* client );
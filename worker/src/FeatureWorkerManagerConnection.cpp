@@ -26,31 +26,50 @@
 #include <QHostAddress>
 
 #include "FeatureManager.h"
+#include "FeatureWorkerManager.h"
 #include "FeatureWorkerManagerConnection.h"
+#include "PlatformNetworkFunctions.h"
 #include "VeyonConfiguration.h"
 
 
 FeatureWorkerManagerConnection::FeatureWorkerManagerConnection( VeyonWorkerInterface& worker,
 																Feature::Uid featureUid,
+																bool useTcp,
 																QObject* parent ) :
 	QObject( parent ),
 	m_worker( worker ),
 	m_port(VeyonCore::config().featureWorkerManagerPort() + VeyonCore::sessionId()),
-	m_socket( this ),
+	m_localSocket( this ),
+	m_tcpSocket( this ),
+	m_useTcp( useTcp ),
 	m_featureUid( featureUid )
 {
 	connect( &m_connectTimer, &QTimer::timeout, this, &FeatureWorkerManagerConnection::tryConnection );
 
-	connect( &m_socket, &QTcpSocket::connected,
-			 this, &FeatureWorkerManagerConnection::sendInitMessage );
+	connect( &m_localSocket, &QLocalSocket::connected,
+			 this, [=]() { handleConnected( &m_localSocket ); } );
+	connect( &m_tcpSocket, &QTcpSocket::connected,
+			 this, [=]() { handleConnected( &m_tcpSocket ); } );
 
-	connect(&m_socket, &QTcpSocket::disconnected, this,
-			[=]() {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	connect( &m_localSocket, &QLocalSocket::errorOccurred,
+			 this, &FeatureWorkerManagerConnection::handleLocalSocketError );
+#else
+	connect( &m_localSocket, static_cast<void(QLocalSocket::*)(QLocalSocket::LocalSocketError)>(&QLocalSocket::error),
+			 this, &FeatureWorkerManagerConnection::handleLocalSocketError );
+#endif
+
+	const auto exitOnDisconnect = [=]() {
 		vDebug() << "lost connection to FeatureWorkerManager – exiting";
 		QCoreApplication::instance()->exit(0);
-	}, Qt::QueuedConnection);
+	};
+
+	connect( &m_localSocket, &QLocalSocket::disconnected, this, exitOnDisconnect, Qt::QueuedConnection );
+	connect( &m_tcpSocket, &QTcpSocket::disconnected, this, exitOnDisconnect, Qt::QueuedConnection );
 
-	connect( &m_socket, &QTcpSocket::readyRead,
+	connect( &m_localSocket, &QLocalSocket::readyRead,
+			 this, &FeatureWorkerManagerConnection::receiveMessage );
+	connect( &m_tcpSocket, &QTcpSocket::readyRead,
 			 this, &FeatureWorkerManagerConnection::receiveMessage );
 
 	tryConnection();
@@ -62,20 +81,68 @@ bool FeatureWorkerManagerConnection::sendMessage( const FeatureMessage& message
 {
 	vDebug() << message;
 
-	return message.sendPlain(&m_socket);
+	return m_socket && message.sendPlain(m_socket);
 }
 
 
 
 void FeatureWorkerManagerConnection::tryConnection()
 {
-	if( m_socket.state() != QTcpSocket::ConnectedState )
+	if( m_socket )
+	{
+		return;
+	}
+
+	if( m_useTcp )
 	{
 		vDebug() << "connecting to FeatureWorkerManager at port" << m_port;
 
-		m_socket.connectToHost(QHostAddress::LocalHost, m_port);
-		m_connectTimer.start(ConnectTimeout);
+		m_tcpSocket.abort();
+		m_tcpSocket.connectToHost(QHostAddress::LocalHost, m_port);
+	}
+	else
+	{
+		vDebug() << "connecting to FeatureWorkerManager at local socket" << FeatureWorkerManager::localServerName();
+
+		m_localSocket.abort();
+#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+		m_localSocket.setSocketOptions( QLocalSocket::AbstractNamespaceOption );
+#endif
+		m_localSocket.connectToServer( FeatureWorkerManager::localServerName() );
 	}
+
+	m_connectTimer.start(ConnectTimeout);
+}
+
+
+
+void FeatureWorkerManagerConnection::handleLocalSocketError()
+{
+	// errors are usually transient (e.g. server not listening yet) so keep retrying through m_connectTimer
+	if( m_socket == nullptr )
+	{
+		vDebug() << "could not connect to local socket" << FeatureWorkerManager::localServerName()
+				 << m_localSocket.errorString() << "– retrying";
+	}
+}
+
+
+
+void FeatureWorkerManagerConnection::handleConnected( QIODevice* socket )
+{
+	if( socket == &m_localSocket &&
+		VeyonCore::platform().networkFunctions().isLocalSocketServerTrusted(
+			PlatformNetworkFunctions::Socket( m_localSocket.socketDescriptor() ) ) == false )
+	{
+		vCritical() << "local socket" << FeatureWorkerManager::localServerName() << "is not owned by Veyon Server – exiting";
+		m_connectTimer.stop();
+		QCoreApplication::instance()->exit(1);
+		return;
+	}
+
+	m_socket = socket;
+
+	sendInitMessage();
 }
 
 
@@ -86,7 +153,7 @@ void FeatureWorkerManagerConnection::sendInitMessage()
 
 	m_connectTimer.stop();
 
-	FeatureMessage(m_featureUid, FeatureMessage::InitCommand).sendPlain(&m_socket);
+	FeatureMessage(m_featureUid, FeatureMessage::InitCommand).sendPlain(m_socket);
 }
 
 
@@ -95,9 +162,25 @@ void FeatureWorkerManagerConnection::receiveMessage()
 {
 	FeatureMessage featureMessage;
 
-	while( featureMessage.isReadyForReceive( &m_socket ) )
+	while( featureMessage.isReadyForReceive( m_socket ) )
 	{
-		if( featureMessage.receive( &m_socket ) )
+		if( featureMessage.receive( m_socket ) == false )
+		{
+			continue;
+		}
+
+		if( m_featureUid.isNull() )
+		{
+			// standby worker gets assigned to a feature
+			if( featureMessage.command() == FeatureMessage::InitCommand &&
+				featureMessage.featureUid().isNull() == false )
+			{
+				m_featureUid = featureMessage.featureUid();
+				Q_EMIT featureAssigned( m_featureUid );
+				sendInitMessage();
+			}
+		}
+		else
 		{
 			VeyonCore::featureManager().handleFeatureMessage( m_worker, featureMessage );
 		}
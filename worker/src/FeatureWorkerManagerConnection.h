@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <QLocalSocket>
 #include <QTcpSocket>
 #include <QTimer>
 
@@ -39,21 +40,30 @@ class FeatureWorkerManagerConnection : public QObject
 public:
 	FeatureWorkerManagerConnection( VeyonWorkerInterface& worker,
 									Feature::Uid featureUid,
+									bool useTcp,
 									QObject* parent = nullptr );
 
 
 	bool sendMessage( const FeatureMessage& message );
 
+Q_SIGNALS:
+	void featureAssigned( Feature::Uid featureUid );
+
 private:
 	static constexpr auto ConnectTimeout = 3000;
 
 	void tryConnection();
+	void handleLocalSocketError();
+	void handleConnected( QIODevice* socket );
 	void sendInitMessage();
 	void receiveMessage();
 
 	VeyonWorkerInterface& m_worker;
 	const int m_port;
-	QTcpSocket m_socket;
+	QLocalSocket m_localSocket;
+	QTcpSocket m_tcpSocket;
+	QIODevice* m_socket{nullptr};
+	const bool m_useTcp;
 	Feature::Uid m_featureUid;
 	QTimer m_connectTimer{this};
 
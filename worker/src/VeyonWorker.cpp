@@ -30,11 +30,47 @@
 #include "VeyonWorker.h"
 
 
-VeyonWorker::VeyonWorker( QUuid featureUid, QObject* parent ) :
+VeyonWorker::VeyonWorker( QUuid featureUid, bool useTcp, QObject* parent ) :
 	QObject( parent ),
 	m_core( QCoreApplication::instance(),
 			VeyonCore::Component::Worker,
-			QStringLiteral( "FeatureWorker-" ) + VeyonCore::formattedUuid( featureUid ) )
+			QStringLiteral( "FeatureWorker-" ) +
+				( featureUid.isNull() ? QStringLiteral("Standby") : VeyonCore::formattedUuid( featureUid ) ) )
+{
+	if( featureUid.isNull() )
+	{
+		vInfo() << "Running standby worker";
+	}
+	else
+	{
+		initFeature( featureUid );
+	}
+
+	m_workerManagerConnection = new FeatureWorkerManagerConnection(*this, featureUid, useTcp);
+
+	connect( m_workerManagerConnection, &FeatureWorkerManagerConnection::featureAssigned,
+			 this, [this]( Feature::Uid assignedFeatureUid ) {
+		// continue logging to the log file of the assigned feature
+		m_core.setAppComponentName( QStringLiteral( "FeatureWorker-" ) + VeyonCore::formattedUuid( assignedFeatureUid ) );
+		initFeature( assignedFeatureUid );
+	} );
+}
+
+
+
+VeyonWorker::~VeyonWorker()
+{
+	vDebug();
+
+	delete m_workerManagerConnection;
+	m_workerManagerConnection = nullptr;
+
+	vDebug() << "finished";
+}
+
+
+
+void VeyonWorker::initFeature( Feature::Uid featureUid )
 {
 	const Feature* workerFeature = nullptr;
 
@@ -56,25 +92,11 @@ VeyonWorker::VeyonWorker( QUuid featureUid, QObject* parent ) :
 		qFatal( "Specified feature is disabled by configuration!" );
 	}
 
-	m_workerManagerConnection = new FeatureWorkerManagerConnection(*this, featureUid);
-
 	vInfo() << "Running worker for feature" << workerFeature->name();
 }
 
 
 
-VeyonWorker::~VeyonWorker()
-{
-	vDebug();
-
-	delete m_workerManagerConnection;
-	m_workerManagerConnection = nullptr;
-
-	vDebug() << "finished";
-}
-
-
-
 bool VeyonWorker::sendFeatureMessageReply( const FeatureMessage& reply )
 {
 	return m_workerManagerConnection &&
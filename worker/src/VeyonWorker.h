@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "Feature.h"
 #include "VeyonCore.h"
 #include "VeyonWorkerInterface.h"
 
@@ -33,7 +34,7 @@ class VeyonWorker : public QObject, VeyonWorkerInterface
 {
 	Q_OBJECT
 public:
-	explicit VeyonWorker( QUuid featureUid, QObject* parent = nullptr );
+	VeyonWorker( QUuid featureUid, bool useTcp, QObject* parent = nullptr );
 	~VeyonWorker() override;
 
 	bool sendFeatureMessageReply( const FeatureMessage& reply ) override;
@@ -44,6 +45,8 @@ public:
 	}
 
 private:
+	void initFeature( Feature::Uid featureUid );
+
 	VeyonCore m_core;
 	FeatureWorkerManagerConnection* m_workerManagerConnection{nullptr};
 
@@ -26,6 +26,7 @@
 #include <QIcon>
 
 #include "Feature.h"
+#include "FeatureWorkerManager.h"
 #include "VeyonWorker.h"
 
 
@@ -43,13 +44,19 @@ int main( int argc, char **argv )
 		qFatal( "Not enough arguments (feature)" );
 	}
 
-	const auto featureUid = Feature::Uid{arguments[1]};
-	if( featureUid.isNull() )
+	// standby workers are started without a feature and get one assigned by the FeatureWorkerManager later
+	const auto isStandbyWorker = arguments[1] == QLatin1String(FeatureWorkerManager::StandbyWorkerArgument);
+
+	const auto featureUid = isStandbyWorker ? Feature::Uid{} : Feature::Uid{arguments[1]};
+	if( featureUid.isNull() && isStandbyWorker == false )
 	{
 		qFatal( "Invalid feature UID given" );
 	}
 
-	VeyonWorker worker( featureUid );
+	// the FeatureWorkerManager only listens on TCP if it could not listen on its local socket
+	const auto useTcp = arguments.count() > 2 && arguments[2] == QLatin1String(FeatureWorkerManager::TcpTransportArgument);
+
+	VeyonWorker worker( featureUid, useTcp );
 
 	return worker.core().exec();
 }